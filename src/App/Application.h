@@ -512,6 +512,8 @@ private:
     static PyObject *sSetActiveTransaction  (PyObject *self,PyObject *args);
     static PyObject *sGetActiveTransaction  (PyObject *self,PyObject *args);
     static PyObject *sCloseActiveTransaction(PyObject *self,PyObject *args);
+    static PyObject *sOpenChangeBatch       (PyObject *self,PyObject *args);
+    static PyObject *sCloseChangeBatch      (PyObject *self,PyObject *args);
     static PyObject *sCheckAbort(PyObject *self,PyObject *args);
     static PyMethodDef    Methods[]; 
 
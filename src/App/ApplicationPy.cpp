@@ -35,6 +35,7 @@
 #include "DocumentPy.h"
 #include "DocumentObserverPython.h"
 #include "DocumentObjectPy.h"
+#include "AutoTransaction.h"
 
 // FreeCAD Base header
 #include <Base/Interpreter.h>
@@ -177,6 +178,15 @@ PyMethodDef Application::Methods[] = {
      "getActiveTransaction() -> (name,id) return the current active transaction name and ID"},     
     {"closeActiveTransaction", (PyCFunction) Application::sCloseActiveTransaction, METH_VARARGS,
      "closeActiveTransaction(abort=False) -- commit or abort current active transaction"},     
+    {"openChangeBatch", (PyCFunction) Application::sOpenChangeBatch, METH_VARARGS,
+     "openChangeBatch() -- defer object change notification until closeChangeBatch()\n\n"
+     "While the batch is open, changed object notification to observers (including the\n"
+     "GUI) is queued once per object and property, and sent in dependency order when\n"
+     "the last batch is closed, or before a document is recomputed. Each call must be\n"
+     "paired with closeChangeBatch(). Prefer the context manager FreeCAD.ChangeBatch(),\n"
+     "which always closes the batch."},
+    {"closeChangeBatch", (PyCFunction) Application::sCloseChangeBatch, METH_VARARGS,
+     "closeChangeBatch() -- close a batch opened by openChangeBatch()"},
     {"isRestoring", (PyCFunction) Application::sIsRestoring, METH_VARARGS,
      "isRestoring() -> Bool -- Test if the application is opening some document"},
     {"checkAbort", (PyCFunction) Application::sCheckAbort, METH_VARARGS,
@@ -961,6 +971,28 @@ PyObject *Application::sCloseActiveTransaction(PyObject * /*self*/, PyObject *ar
     } PY_CATCH;
 }
 
+PyObject *Application::sOpenChangeBatch(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        ChangeBatch::open();
+        Py_Return;
+    } PY_CATCH;
+}
+
+PyObject *Application::sCloseChangeBatch(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        ChangeBatch::close();
+        Py_Return;
+    } PY_CATCH;
+}
+
 PyObject *Application::sCheckAbort(PyObject * /*self*/, PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
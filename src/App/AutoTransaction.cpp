@@ -22,11 +22,18 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <algorithm>
+# include <unordered_map>
+#endif
+
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include "Application.h"
 #include "Transactions.h"
 #include "Document.h"
+#include "DocumentObject.h"
+#include "DocumentObserver.h"
 #include "AutoTransaction.h"
 
 FC_LOG_LEVEL_INIT("App",true,true)
@@ -240,3 +247,118 @@ bool TransactionLocker::isLocked() {
 }
 
 
+
+////////////////////////////////////////////////////////////////////////
+
+static int _ChangeBatchCount;
+
+struct PendingChange {
+    DocumentObjectT obj;
+    std::vector<std::string> props;
+};
+static std::vector<PendingChange> _PendingChanges;
+static std::unordered_map<std::string, std::size_t> _PendingChangeMap;
+
+ChangeBatch::ChangeBatch()
+{
+    open();
+}
+
+ChangeBatch::~ChangeBatch()
+{
+    if(_ChangeBatchCount<=0 || --_ChangeBatchCount!=0)
+        return;
+    try {
+        flush();
+        return;
+    } catch (Base::Exception &e) {
+        e.ReportException();
+    } catch (Py::Exception &) {
+        Base::PyException e;
+        e.ReportException();
+    } catch (std::exception &e) {
+        FC_ERR(e.what());
+    } catch (...) {
+    }
+    FC_ERR("Exception when flushing change notification");
+}
+
+void ChangeBatch::open()
+{
+    ++_ChangeBatchCount;
+}
+
+void ChangeBatch::close()
+{
+    if(_ChangeBatchCount<=0)
+        FC_THROWM(Base::RuntimeError, "No active change batch");
+    if(--_ChangeBatchCount==0)
+        flush();
+}
+
+bool ChangeBatch::isActive()
+{
+    return _ChangeBatchCount > 0;
+}
+
+bool ChangeBatch::deferChange(const DocumentObject *obj, const Property *prop)
+{
+    if(_ChangeBatchCount<=0 || !obj || !obj->getNameInDocument() || !prop)
+        return false;
+    const char *propName = prop->getName();
+    if(!propName)
+        return false;
+
+    auto res = _PendingChangeMap.insert(std::make_pair(obj->getFullName(), _PendingChanges.size()));
+    if(res.second) {
+        _PendingChanges.emplace_back();
+        _PendingChanges.back().obj = obj;
+    }
+    auto &props = _PendingChanges[res.first->second].props;
+    if(std::find(props.begin(),props.end(),propName) == props.end())
+        props.emplace_back(propName);
+    return true;
+}
+
+void ChangeBatch::flush()
+{
+    if(_PendingChanges.empty())
+        return;
+
+    std::vector<PendingChange> changes;
+    changes.swap(_PendingChanges);
+    _PendingChangeMap.clear();
+
+    std::vector<DocumentObject*> objs;
+    std::unordered_map<DocumentObject*, PendingChange*> changeMap;
+    for(auto &change : changes) {
+        auto obj = change.obj.getObject();
+        if(obj && changeMap.emplace(obj, &change).second)
+            objs.push_back(obj);
+    }
+
+    if(objs.size() > 1) {
+        try {
+            // The returned list also contains the dependencies, which are
+            // filtered out below
+            objs = Document::getDependencyList(objs, Document::DepSort);
+        } catch (Base::Exception &e) {
+            e.ReportException();
+        }
+    }
+
+    for(auto o : objs) {
+        auto it = changeMap.find(o);
+        if(it == changeMap.end())
+            continue;
+        for(auto &propName : it->second->props) {
+            // Resolve again in case the object is deleted by previous notification
+            auto obj = it->second->obj.getObject();
+            if(!obj)
+                break;
+            auto prop = obj->getPropertyByName(propName.c_str());
+            if(prop)
+                obj->getDocument()->signalChangedObject(*obj, *prop);
+        }
+    }
+}
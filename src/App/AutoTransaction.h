@@ -126,6 +126,61 @@ private:
     bool active;
 };
 
+class DocumentObject;
+class Property;
+
+/** Helper class to batch property change notifications
+ *
+ * While any instance of this class is alive, the signalChangedObject of
+ * App::Document (and hence those of App::Application and any GUI
+ * observer) is not emitted on each property change. Instead, the change is
+ * remembered once per object and property, and all pending notifications
+ * are sent when the last batch ends, with objects ordered by their
+ * dependencies.
+ *
+ * Note that only the external notification is deferred. The owner object's
+ * onChanged() is still called immediately, so that the object itself stays
+ * consistent. Because observers may mark objects for recompute when notified,
+ * App::Document flushes the pending notification before any recompute.
+ *
+ * In Python, use the context manager FreeCAD.ChangeBatch(), which closes the
+ * batch even if an exception is raised.
+ */
+class AppExport ChangeBatch {
+public:
+    /// Constructor, opens a new batch
+    ChangeBatch();
+
+    /// Destructor, closes the batch and flushes the notification if it is the last one
+    ~ChangeBatch();
+
+    /// Open a batch, must be paired with close()
+    static void open();
+
+    /** Close a batch opened by open()
+     *
+     * Pending notifications are sent when the last batch is closed. Throws
+     * Base::RuntimeError if there is no active batch.
+     */
+    static void close();
+
+    /// Check if there is any active batch
+    static bool isActive();
+
+    /** Called by App::Document to check whether the change notification shall be deferred
+     * @return Return true if the change is queued
+     */
+    static bool deferChange(const DocumentObject *obj, const Property *prop);
+
+    /// Send the pending notification now, without closing any batch
+    static void flush();
+
+private:
+
+    /// Private new operator to prevent heap allocation
+    void* operator new(size_t size);
+};
+
 } // namespace App
 
 #endif // APP_AUTOTRANSACTION_H
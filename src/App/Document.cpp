@@ -1506,6 +1506,8 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if(ChangeBatch::deferChange(Who,What))
+        return;
     signalChangedObject(*Who, *What);
 }
 
@@ -2611,7 +2613,7 @@ bool Document::saveToFile(const char* filename) const
         writer.setLevel(compression);
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false))
+        if (hGrp->GetBool("SaveBinaryBrep", true))
             writer.setMode("BinaryBrep");
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
@@ -3419,6 +3421,10 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
         return 0;
     }
 
+    // observers may touch objects when notified of a change, so send any
+    // notification deferred by an open ChangeBatch first
+    ChangeBatch::flush();
+
     // delete recompute log
     d->clearRecomputeLog();
 
@@ -3773,6 +3779,8 @@ int Document::_recomputeFeature(DocumentObject* Feat)
 
 bool Document::recomputeFeature(DocumentObject* Feat, bool recursive)
 {
+    ChangeBatch::flush();
+
     // delete recompute log
     d->clearRecomputeLog(Feat);
 
@@ -3832,7 +3840,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
     pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
-    pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    pcObject->_setNameInDocument(&(d->objectMap.find(ObjectName)->first));
     // insert in the vector
     d->objectArray.push_back(pcObject);
     // insert in the adjacence list and reference through the ConectionMap
@@ -3934,7 +3942,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         pcObject->_Id = ++d->lastObjectId;
         d->objectIdMap[pcObject->_Id] = pcObject;
         // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
-        pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+        pcObject->_setNameInDocument(&(d->objectMap.find(ObjectName)->first));
         // insert in the vector
         d->objectArray.push_back(pcObject);
 
@@ -3998,7 +4006,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
-    pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    pcObject->_setNameInDocument(&(d->objectMap.find(ObjectName)->first));
     // insert in the vector
     d->objectArray.push_back(pcObject);
 
@@ -4029,7 +4037,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
-    pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    pcObject->_setNameInDocument(&(d->objectMap.find(ObjectName)->first));
 
     // do no transactions if we do a rollback!
     if (!d->rollback) {
@@ -25,6 +25,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <atomic>
+# include <map>
+# include <mutex>
+# include <tuple>
 #endif
 
 #include <Base/Writer.h>
@@ -41,6 +45,7 @@
 #include "PropertyExpressionEngine.h"
 #include "DocumentObjectExtension.h"
 #include "GeoFeatureGroupExtension.h"
+#include "Link.h"
 #include <App/DocumentObjectPy.h>
 #include <boost/bind/bind.hpp>
 
@@ -48,6 +53,30 @@ FC_LOG_LEVEL_INIT("App",true,true)
 
 using namespace App;
 
+// Increased on any change of a link. Starts at one so that zero means 'not
+// cached'.
+static std::atomic<unsigned long> _LinkRevision(1);
+// Guards the memoized recursive in/out lists, see getInListRecursiveSet()
+static std::mutex _RecursiveListMutex;
+// Objects holding at least one valid memoized recursive list
+static std::set<const DocumentObject*> _RecursiveListObjects;
+// Increased on any change that may affect getSubObject(), see getSubObjectRevision()
+static std::atomic<unsigned long> _SubObjectRevision(1);
+// Set by getSubObject() implementations whose result must not be cached, see
+// skipSubObjectCache()
+static thread_local bool _SkipSubObjectCache;
+
+// Sub-objects are resolved by the link properties and accumulate the
+// placements. Link objects also resolve by their other properties (e.g.
+// ElementCount, LinkTransform or Scale).
+static bool _isSubObjectProperty(const DocumentObject *obj, const Property *prop)
+{
+    return prop->isDerivedFrom(PropertyPlacement::getClassTypeId())
+        || prop->isDerivedFrom(PropertyPlacementList::getClassTypeId())
+        || prop->isDerivedFrom(PropertyLinkBase::getClassTypeId())
+        || obj->hasExtension(LinkBaseExtension::getExtensionClassTypeId());
+}
+
 /** \defgroup DocObject Document Object
     \ingroup APP
     \brief Base class of all objects handled in the Document
@@ -82,6 +111,12 @@ DocumentObject::DocumentObject(void)
 
 DocumentObject::~DocumentObject(void)
 {
+    ++_LinkRevision;
+    {
+        std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+        _RecursiveListObjects.erase(this);
+    }
+
     if (!PythonObject.is(Py::_None())){
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -256,10 +291,19 @@ bool DocumentObject::isAttachedToDocument() const
 const char* DocumentObject::detachFromDocument()
 {
     const std::string* name = pcNameInDocument;
-    pcNameInDocument = 0;
+    _setNameInDocument(0);
     return name ? name->c_str() : 0;
 }
 
+void DocumentObject::_setNameInDocument(const std::string *name)
+{
+    pcNameInDocument = name;
+    ++_LinkRevision;
+    // The memoized in/out lists only contain attached objects. Attaching may
+    // reconnect any number of them, so just drop all lists.
+    _clearRecursiveLists();
+}
+
 const std::vector<DocumentObject*> &DocumentObject::getOutList() const {
     if(!_outListCached) {
         _outList.clear();
@@ -436,6 +480,13 @@ void DocumentObject::getInListEx(std::set<App::DocumentObject*> &inSet,
         return;
     }
 
+    if(!inList) {
+        std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+        const auto &res = _getInListRecursiveSet();
+        inSet.insert(res.begin(),res.end());
+        return;
+    }
+
     std::stack<DocumentObject*> pendings;
     pendings.push(const_cast<DocumentObject*>(this));
     while(pendings.size()) {
@@ -459,6 +510,101 @@ std::set<App::DocumentObject*> DocumentObject::getInListEx(bool recursive) const
     return ret;
 }
 
+unsigned long DocumentObject::getLinkRevision() {
+    return _LinkRevision;
+}
+
+unsigned long DocumentObject::getSubObjectRevision() {
+    return _SubObjectRevision;
+}
+
+void DocumentObject::skipSubObjectCache() {
+    _SkipSubObjectCache = true;
+}
+
+std::set<App::DocumentObject*> DocumentObject::getInListRecursiveSet() const {
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    return _getInListRecursiveSet();
+}
+
+std::set<App::DocumentObject*> DocumentObject::getOutListRecursiveSet() const {
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    return _getOutListRecursiveSet();
+}
+
+const std::set<App::DocumentObject*> &DocumentObject::_getInListRecursiveSet() const {
+    if(_inListRecursiveValid)
+        return _inListRecursive;
+
+    _inListRecursive.clear();
+#ifdef USE_OLD_DAG
+    getInListEx(_inListRecursive,true);
+#else
+    std::stack<const DocumentObject*> pendings;
+    pendings.push(this);
+    while(pendings.size()) {
+        auto obj = pendings.top();
+        pendings.pop();
+        for(auto o : obj->getInList()) {
+            if(o && o->getNameInDocument() && _inListRecursive.insert(o).second)
+                pendings.push(o);
+        }
+    }
+#endif
+    _inListRecursiveValid = true;
+    _RecursiveListObjects.insert(this);
+    return _inListRecursive;
+}
+
+const std::set<App::DocumentObject*> &DocumentObject::_getOutListRecursiveSet() const {
+    if(_outListRecursiveValid)
+        return _outListRecursive;
+
+    _outListRecursive.clear();
+    std::stack<const DocumentObject*> pendings;
+    pendings.push(this);
+    while(pendings.size()) {
+        auto obj = pendings.top();
+        pendings.pop();
+        for(auto o : obj->getOutList()) {
+            if(o && o->getNameInDocument() && _outListRecursive.insert(o).second)
+                pendings.push(o);
+        }
+    }
+    _outListRecursiveValid = true;
+    _RecursiveListObjects.insert(this);
+    return _outListRecursive;
+}
+
+void DocumentObject::_clearRecursiveLists() {
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    for(auto obj : _RecursiveListObjects) {
+        obj->_inListRecursiveValid = false;
+        obj->_outListRecursiveValid = false;
+    }
+    _RecursiveListObjects.clear();
+}
+
+void DocumentObject::_onLinkChanged(const DocumentObject *parent, const DocumentObject *child) {
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    // A link from parent to child only changes the in lists of child and of
+    // the objects depending on it, and the out lists of parent and of the
+    // objects it depends on. So only drop the lists that contain them.
+    for(auto it=_RecursiveListObjects.begin();it!=_RecursiveListObjects.end();) {
+        auto obj = *it;
+        if(obj->_inListRecursiveValid && (obj==child
+                    || obj->_inListRecursive.count(const_cast<DocumentObject*>(child))))
+            obj->_inListRecursiveValid = false;
+        if(obj->_outListRecursiveValid && (obj==parent
+                    || obj->_outListRecursive.count(const_cast<DocumentObject*>(parent))))
+            obj->_outListRecursiveValid = false;
+        if(obj->_inListRecursiveValid || obj->_outListRecursiveValid)
+            ++it;
+        else
+            it = _RecursiveListObjects.erase(it);
+    }
+}
+
 void _getOutListRecursive(std::set<DocumentObject*>& objSet,
                           const DocumentObject* obj,
                           const DocumentObject* checkObj, int depth)
@@ -521,7 +667,10 @@ bool DocumentObject::isInInListRecursive(DocumentObject *linkTo) const
     int maxDepth = getDocument()->countObjects() + 2;
     return _isInInListRecursive(this, linkTo, maxDepth);
 #else
-    return this==linkTo || getInListEx(true).count(linkTo);
+    if(this == linkTo)
+        return true;
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    return _getInListRecursiveSet().count(linkTo) != 0;
 #endif
 }
 
@@ -600,10 +749,10 @@ bool DocumentObject::testIfLinkDAGCompatible(const std::vector<DocumentObject *>
     else
         return true;
 #else
-    auto inLists = getInListEx(true);
-    inLists.emplace(const_cast<DocumentObject*>(this));
+    std::lock_guard<std::mutex> lock(_RecursiveListMutex);
+    const auto &inLists = _getInListRecursiveSet();
     for(auto obj : linksTo)
-        if(inLists.count(obj))
+        if(obj == this || inLists.count(obj))
             return false;
     return true;
 #endif
@@ -686,6 +835,10 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (prop == &Label)
         oldLabel = Label.getStrValue();
 
+    // Label is included because of the '$Label' form of subname
+    if (prop == &Label || _isSubObjectProperty(this, prop))
+        ++_SubObjectRevision;
+
     if (_pDoc)
         onBeforeChangeProperty(_pDoc, prop);
 
@@ -719,6 +872,9 @@ void DocumentObject::onChanged(const Property* prop)
     if (prop == &Label && _pDoc && oldLabel != Label.getStrValue())
         _pDoc->signalRelabelObject(*this);
 
+    if (prop == &Label || _isSubObjectProperty(this, prop))
+        ++_SubObjectRevision;
+
     // set object touched if it is an input property
     if (!testStatus(ObjectStatus::NoTouch) 
             && !(prop->getType() & Prop_Output) 
@@ -744,6 +900,15 @@ void DocumentObject::onChanged(const Property* prop)
 }
 
 void DocumentObject::clearOutListCache() const {
+    ++_LinkRevision;
+#ifdef USE_OLD_DAG
+    // there are no back links to tell which objects are affected
+    _clearRecursiveLists();
+#else
+    // The back links are updated before the out list is cleared, so drop
+    // any out list memoized from the stale cache in between.
+    _onLinkChanged(this, 0);
+#endif
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
@@ -807,6 +972,93 @@ DocumentObject *DocumentObject::getSubObject(const char *subname,
     return ret;
 }
 
+namespace {
+// Cache used by getSubObjectCached(). All entries are dropped as soon as any
+// placement or link changes. Detaching or re-attaching an object changes the
+// link revision, too.
+struct SubObjectCache {
+    struct Entry {
+        DocumentObject *obj;
+        Base::Matrix4D mat;
+    };
+    // key is the object, the subname and the flags (1: transform, 2: matrix)
+    typedef std::tuple<const DocumentObject*, std::string, int> Key;
+
+    std::mutex mutex;
+    unsigned long subObjectRevision = 0;
+    unsigned long linkRevision = 0;
+    std::map<Key, Entry> entries;
+
+    bool isValid() const {
+        return subObjectRevision == DocumentObject::getSubObjectRevision()
+            && linkRevision == DocumentObject::getLinkRevision();
+    }
+};
+
+SubObjectCache &_SubObjectCache() {
+    static SubObjectCache cache;
+    return cache;
+}
+
+// upper limit of cached entries before the cache is flushed
+const std::size_t _SubObjectCacheSize = 10000;
+}
+
+DocumentObject *DocumentObject::getSubObjectCached(const char *subname,
+        Base::Matrix4D *mat, bool transform) const
+{
+    auto &cache = _SubObjectCache();
+    SubObjectCache::Key key(this, subname?subname:"", (transform?1:0)|(mat?2:0));
+    unsigned long subObjectRevision = getSubObjectRevision();
+    unsigned long linkRevision = getLinkRevision();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if(!cache.isValid()) {
+            cache.entries.clear();
+            cache.subObjectRevision = subObjectRevision;
+            cache.linkRevision = linkRevision;
+        }
+        else {
+            auto it = cache.entries.find(key);
+            if(it != cache.entries.end()) {
+                if(mat)
+                    *mat *= it->second.mat;
+                return it->second.obj;
+            }
+        }
+    }
+
+    // Resolve outside the lock as getSubObject() may recurse into here. All
+    // C++ implementations only ever right multiply the passed matrix, so the
+    // transformation relative to the input can be cached. Anything resolved
+    // through a Python override is not cached at all, because it may return
+    // any matrix and depend on state that is not tracked by the revisions.
+    bool skip = _SkipSubObjectCache;
+    _SkipSubObjectCache = false;
+    Base::Matrix4D subMat;
+    auto ret = getSubObject(subname,0,mat?&subMat:0,transform);
+    if(mat)
+        *mat *= subMat;
+    bool noCache = _SkipSubObjectCache;
+    // propagate to the caller in case of a nested call
+    _SkipSubObjectCache = skip || noCache;
+    if(noCache)
+        return ret;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if(cache.subObjectRevision == subObjectRevision
+            && cache.linkRevision == linkRevision
+            && cache.isValid())
+    {
+        if(cache.entries.size() >= _SubObjectCacheSize)
+            cache.entries.clear();
+        SubObjectCache::Entry &entry = cache.entries[key];
+        entry.obj = ret;
+        entry.mat = subMat;
+    }
+    return ret;
+}
+
 std::vector<DocumentObject*> DocumentObject::getSubObjectList(const char *subname) const {
     std::vector<DocumentObject*> res;
     res.push_back(const_cast<DocumentObject*>(this));
@@ -816,7 +1068,7 @@ std::vector<DocumentObject*> DocumentObject::getSubObjectList(const char *subnam
     for(auto pos=sub.find('.');pos!=std::string::npos;pos=sub.find('.',pos+1)) {
         char c = sub[pos+1];
         sub[pos+1] = 0;
-        auto sobj = getSubObject(sub.c_str());
+        auto sobj = getSubObjectCached(sub.c_str());
         if(!sobj || !sobj->getNameInDocument())
             break;
         res.push_back(sobj);
@@ -971,8 +1223,11 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
     //do not use erase-remove idom, as this erases ALL entries that match. we only want to remove a
     //single one.
     auto it = std::find(_inList.begin(), _inList.end(), rmvObj);
-    if(it != _inList.end())
+    if(it != _inList.end()) {
         _inList.erase(it);
+        ++_LinkRevision;
+        _onLinkChanged(rmvObj, this);
+    }
 #else
     (void)rmvObj;
 #endif
@@ -986,6 +1241,8 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     //this removal would clear the object from the inlist, even though there may be other link properties 
     //from this object that link to us.
     _inList.push_back(newObj);
+    ++_LinkRevision;
+    _onLinkChanged(newObj, this);
 #else
     (void)newObj;
 #endif //USE_OLD_DAG    
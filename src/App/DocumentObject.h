@@ -252,6 +252,35 @@ public:
      * @param recursive [in]: whether to obtain recursive in list
      */
     std::set<App::DocumentObject*> getInListEx(bool recursive) const;
+    /** Return a memoized set of all objects linking directly or indirectly to this object
+     *
+     * The set is computed on demand and kept until a link into this object
+     * or into one of the returned objects changes, or until any object is
+     * attached to or detached from a document. The sets are guarded by a
+     * mutex, but like getOutList(), they must not be queried from other
+     * threads while the links are being changed.
+     */
+    std::set<App::DocumentObject*> getInListRecursiveSet() const;
+    /** Return a memoized set of all objects this object depends on directly or indirectly
+     *
+     * Same caching rules as getInListRecursiveSet() apply. In contrast to
+     * getOutListRecursive() cyclic dependencies do not throw.
+     */
+    std::set<App::DocumentObject*> getOutListRecursiveSet() const;
+    /// Return a counter that is increased whenever a link between any objects changes
+    static unsigned long getLinkRevision();
+    /** Return a counter that is increased whenever a property changes that
+     * may affect the result of getSubObject(), i.e. a placement, a link or any
+     * property of a link object (see LinkBaseExtension)
+     */
+    static unsigned long getSubObjectRevision();
+    /** Mark the result of the getSubObject() call in progress as not cacheable
+     *
+     * To be called by getSubObject() implementations that do not only depend
+     * on placements and links, e.g. Python overrides. The current call of
+     * getSubObjectCached() in this thread will then bypass the cache.
+     */
+    static void skipSubObjectCache();
 
     /// get group if object is part of a group, otherwise 0 is returned
     DocumentObjectGroup* getGroup() const;
@@ -348,6 +377,23 @@ public:
     virtual DocumentObject *getSubObject(const char *subname, PyObject **pyObj=0, 
             Base::Matrix4D *mat=0, bool transform=true, int depth=0) const;
 
+    /** Get the sub object by name using a cache
+     *
+     * Same as getSubObject() without the Python object output. The resolved
+     * object and the accumulated transformation are cached by this object and
+     * \c subname until any placement or link changes, see
+     * getSubObjectRevision() and getLinkRevision(). Paths resolved through a
+     * Python override of getSubObject() are never cached, see
+     * skipSubObjectCache().
+     *
+     * The cache itself is guarded by a mutex, but a miss calls getSubObject()
+     * which is not thread safe, and it may run Python code. So callers must
+     * stay on the main thread. Worker threads may only use it for paths that
+     * have already been resolved on the main thread since the last change.
+     */
+    DocumentObject *getSubObjectCached(const char *subname,
+            Base::Matrix4D *mat=0, bool transform=true) const;
+
     /// Return a list of objects referenced by a given subname including this object
     std::vector<DocumentObject*> getSubObjectList(const char *subname) const;
 
@@ -621,6 +667,18 @@ private:
     // accessed by App::Document to record and restore the correct view provider type
     std::string _pcViewProviderName;
 
+    // accessed by App::Document to attach the object, this changes the result of
+    // the memoized recursive in/out lists and therefore increases the link revision
+    void _setNameInDocument(const std::string *name);
+
+    // memoized recursive in/out lists, the caller must hold the list mutex
+    const std::set<App::DocumentObject*> &_getInListRecursiveSet() const;
+    const std::set<App::DocumentObject*> &_getOutListRecursiveSet() const;
+    // drop the memoized lists affected by a link from parent to child
+    static void _onLinkChanged(const DocumentObject *parent, const DocumentObject *child);
+    // drop all memoized lists
+    static void _clearRecursiveLists();
+
     // unique identifier (among a document) of this object.
     long _Id;
     
@@ -631,6 +689,11 @@ private:
     mutable std::vector<App::DocumentObject *> _outList;
     mutable std::unordered_map<const char *, App::DocumentObject*, CStringHasher, CStringHasher> _outListMap;
     mutable bool _outListCached = false;
+    // memoized recursive in/out lists, see getInListRecursiveSet()
+    mutable std::set<App::DocumentObject*> _inListRecursive;
+    mutable std::set<App::DocumentObject*> _outListRecursive;
+    mutable bool _inListRecursiveValid = false;
+    mutable bool _outListRecursiveValid = false;
 };
 
 } //namespace App
@@ -227,6 +227,7 @@ bool FeaturePythonImp::getSubObject(DocumentObject *&ret, const char *subname,
     PyObject **pyObj, Base::Matrix4D *_mat, bool transform, int depth) const
 {
     FC_PY_CALL_CHECK(getSubObject);
+    DocumentObject::skipSubObjectCache();
     Base::PyGILStateLocker lock;
     try {
         Py::Tuple args(6);
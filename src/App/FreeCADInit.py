@@ -618,6 +618,27 @@ class FCADLogger(object):
 
 FreeCAD.Logger = FCADLogger
 
+class ChangeBatch(object):
+    '''Context manager to batch object change notification.
+
+       Example usage:
+           >>> with FreeCAD.ChangeBatch():
+           ...     for obj in objs:
+           ...         obj.Placement = pla
+
+       See FreeCAD.openChangeBatch(). The batch is closed when leaving the
+       block, even if an exception is raised.
+    '''
+    def __enter__(self):
+        FreeCAD.openChangeBatch()
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        FreeCAD.closeChangeBatch()
+        return False
+
+FreeCAD.ChangeBatch = ChangeBatch
+
 # init every application by importing Init.py
 try:
 	import traceback
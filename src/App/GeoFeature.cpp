@@ -104,7 +104,7 @@ DocumentObject *GeoFeature::resolveElement(DocumentObject *obj, const char *subn
         subname = "";
     const char *element = Data::ComplexGeoData::findElementName(subname);
     if(_element) *_element = element;
-    auto sobj = obj->getSubObject(subname);
+    auto sobj = obj->getSubObjectCached(subname);
     if(!sobj)
         return 0;
     obj = sobj->getLinkedObject(true);
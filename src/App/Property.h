@@ -232,6 +232,24 @@ public:
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
 
+    /** Returns a record of the value that is about to change (for transactions)
+     *
+     * The default implementation returns a full Copy(). Properties holding
+     * large data may share data that is not modified in place with the
+     * record, or return a partial record (a delta) holding only the values
+     * that are about to change. The record is passed to Paste() on undo/redo.
+     */
+    virtual Property *CopyOnChange(void) const { return Copy(); }
+    /// Returns true if this is a partial record created by CopyOnChange()
+    virtual bool isDelta(void) const { return false; }
+    /** Merges the pending change into a partial record of an earlier change
+     *
+     * This is called when the property changes again inside the same
+     * transaction. If false is returned the transaction stores a full copy
+     * instead.
+     */
+    virtual bool MergeDelta(Property &/*delta*/) const { return false; }
+
     /// Called when a child property has changed value
     virtual void hasSetChildValue(Property &) {}
     /// Called before a child property changing value
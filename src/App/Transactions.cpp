@@ -367,10 +367,19 @@ void TransactionObject::setProperty(const Property* pcProp)
     if(!data.property && data.name.empty()) {
         static_cast<DynamicProperty::PropData&>(data) = 
             pcProp->getContainer()->getDynamicPropertyData(pcProp);
-        data.property = pcProp->Copy();
+        data.property = pcProp->CopyOnChange();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
+    else if(data.property && data.property->isDelta() && !pcProp->MergeDelta(*data.property)) {
+        // The partial record cannot hold the new change, so replace it with a
+        // full copy of the value as it was before this transaction
+        Property *prop = pcProp->Copy();
+        prop->Paste(*data.property);
+        prop->setStatusValue(data.property->getStatus());
+        delete data.property;
+        data.property = prop;
+    }
 }
 
 void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
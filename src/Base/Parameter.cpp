@@ -361,6 +361,7 @@ Base::Reference<ParameterGrp> ParameterGrp::GetGroup(const char* Name)
 
 Base::Reference<ParameterGrp> ParameterGrp::_GetGroup(const char* Name)
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     Base::Reference<ParameterGrp> rParamGrp;
     DOMElement *pcTemp;
 
@@ -382,6 +383,7 @@ Base::Reference<ParameterGrp> ParameterGrp::_GetGroup(const char* Name)
 
 std::vector<Base::Reference<ParameterGrp> > ParameterGrp::GetGroups(void)
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     Base::Reference<ParameterGrp> rParamGrp;
     std::vector<Base::Reference<ParameterGrp> >  vrParamGrp;
     DOMElement *pcTemp; //= _pGroupNode->getFirstChild();
@@ -407,6 +409,7 @@ std::vector<Base::Reference<ParameterGrp> > ParameterGrp::GetGroups(void)
 /// test if this group is empty
 bool ParameterGrp::IsEmpty(void) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     if ( _pGroupNode->getFirstChild() )
         return false;
     else
@@ -416,6 +419,7 @@ bool ParameterGrp::IsEmpty(void) const
 /// test if a special sub group is in this group
 bool ParameterGrp::HasGroup(const char* Name) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     if ( _GroupMap.find(Name) != _GroupMap.end() )
         return true;
 
@@ -427,24 +431,21 @@ bool ParameterGrp::HasGroup(const char* Name) const
 
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+    std::shared_ptr<const ValueSnapshot> values = GetValues();
+    auto it = values->Bools.find(Name);
     // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    return it != values->Bools.end() ? it->second : bPreset;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // find or create the Element
     DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCBool",Name);
     if (pcElem) {
         // and set the value
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+        lock.unlock();
         // trigger observer
         Notify(Name);
     }
@@ -452,6 +453,7 @@ void  ParameterGrp::SetBool(const char* Name, bool bValue)
 
 std::vector<bool> ParameterGrp::GetBools(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<bool>  vrValues;
     DOMElement *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -474,6 +476,7 @@ std::vector<bool> ParameterGrp::GetBools(const char * sFilter) const
 
 std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::pair<std::string,bool> >  vrValues;
     DOMElement *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -496,16 +499,15 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+    std::shared_ptr<const ValueSnapshot> values = GetValues();
+    auto it = values->Ints.find(Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    return it != values->Ints.end() ? it->second : lPreset;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     char cBuf[256];
     // find or create the Element
     DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCInt",Name);
@@ -513,6 +515,7 @@ void  ParameterGrp::SetInt(const char* Name, long lValue)
         // and set the value
         sprintf(cBuf,"%li",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        lock.unlock();
         // trigger observer
         Notify(Name);
     }
@@ -520,6 +523,7 @@ void  ParameterGrp::SetInt(const char* Name, long lValue)
 
 std::vector<long> ParameterGrp::GetInts(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<long>  vrValues;
     DOMNode *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -539,6 +543,7 @@ std::vector<long> ParameterGrp::GetInts(const char * sFilter) const
 
 std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::pair<std::string,long> > vrValues;
     DOMNode *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -559,16 +564,15 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+    std::shared_ptr<const ValueSnapshot> values = GetValues();
+    auto it = values->Unsigneds.find(Name);
     // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    return it != values->Unsigneds.end() ? it->second : lPreset;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     char cBuf[256];
     // find or create the Element
     DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCUInt",Name);
@@ -576,6 +580,7 @@ void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
         // and set the value
         sprintf(cBuf,"%lu",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        lock.unlock();
         // trigger observer
         Notify(Name);
     }
@@ -583,6 +588,7 @@ void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
 
 std::vector<unsigned long> ParameterGrp::GetUnsigneds(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<unsigned long>  vrValues;
     DOMNode *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -602,6 +608,7 @@ std::vector<unsigned long> ParameterGrp::GetUnsigneds(const char * sFilter) cons
 
 std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::pair<std::string,unsigned long> > vrValues;
     DOMNode *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -622,16 +629,15 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+    std::shared_ptr<const ValueSnapshot> values = GetValues();
+    auto it = values->Floats.find(Name);
     // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    return it != values->Floats.end() ? it->second : dPreset;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     char cBuf[256];
     // find or create the Element
     DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCFloat",Name);
@@ -639,6 +645,7 @@ void  ParameterGrp::SetFloat(const char* Name, double dValue)
         // and set the value
         sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        lock.unlock();
         // trigger observer
         Notify(Name);
     }
@@ -646,6 +653,7 @@ void  ParameterGrp::SetFloat(const char* Name, double dValue)
 
 std::vector<double> ParameterGrp::GetFloats(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<double>  vrValues;
     DOMElement *pcTemp ;//= _pGroupNode->getFirstChild();
     std::string Name;
@@ -665,6 +673,7 @@ std::vector<double> ParameterGrp::GetFloats(const char * sFilter) const
 
 std::vector<std::pair<std::string,double> > ParameterGrp::GetFloatMap(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::pair<std::string,double> > vrValues;
     DOMElement *pcTemp ;//= _pGroupNode->getFirstChild();
     std::string Name;
@@ -699,6 +708,7 @@ void ParameterGrp::GetBlob(const char* /*Name*/, void* /*pBuf*/, long /*lMaxLeng
 
 void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // find or create the Element
     DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCText",Name);
     if (pcElem) {
@@ -712,6 +722,7 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
         else {
             pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
         }
+        lock.unlock();
         // trigger observer
         Notify(Name);
     }
@@ -719,28 +730,20 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
+    std::shared_ptr<const ValueSnapshot> values = GetValues();
+    auto it = values->ASCIIs.find(Name);
+    if (it != values->ASCIIs.end())
+        return it->second;
     // if not return preset
-    if (!pcElem) {
-        if (pPreset==0)
-            return std::string("");
-        else
-            return std::string(pPreset);
-    }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
     else if (pPreset==0)
         return std::string("");
-
     else
         return std::string(pPreset);
 }
 
 std::vector<std::string> ParameterGrp::GetASCIIs(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::string>  vrValues;
     DOMElement *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -763,6 +766,7 @@ std::vector<std::string> ParameterGrp::GetASCIIs(const char * sFilter) const
 
 std::vector<std::pair<std::string,std::string> > ParameterGrp::GetASCIIMap(const char * sFilter) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<std::pair<std::string,std::string> >  vrValues;
     DOMElement *pcTemp;// = _pGroupNode->getFirstChild();
     std::string Name;
@@ -788,6 +792,7 @@ std::vector<std::pair<std::string,std::string> > ParameterGrp::GetASCIIMap(const
 
 void ParameterGrp::RemoveASCII(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // check if Element in group
     DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
     // if not return
@@ -796,6 +801,7 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -803,6 +809,7 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
 void ParameterGrp::RemoveBool(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // check if Element in group
     DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
     // if not return
@@ -811,6 +818,7 @@ void ParameterGrp::RemoveBool(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -831,6 +839,7 @@ void ParameterGrp::RemoveBlob(const char* /*Name*/)
 
 void ParameterGrp::RemoveFloat(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // check if Element in group
     DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
     // if not return
@@ -839,6 +848,7 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -846,6 +856,7 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
 void ParameterGrp::RemoveInt(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // check if Element in group
     DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
     // if not return
@@ -854,6 +865,7 @@ void ParameterGrp::RemoveInt(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -861,6 +873,7 @@ void ParameterGrp::RemoveInt(const char* Name)
 
 void ParameterGrp::RemoveUnsigned(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     // check if Element in group
     DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
     // if not return
@@ -869,6 +882,7 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -876,6 +890,7 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
 
 void ParameterGrp::RemoveGrp(const char* Name)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     auto it = _GroupMap.find(Name);
     if (it == _GroupMap.end())
         return;
@@ -884,7 +899,9 @@ void ParameterGrp::RemoveGrp(const char* Name)
     // it cannot be deleted
 #if 1
     if (!it->second->ShouldRemove()) {
-        it->second->Clear();
+        Base::Reference<ParameterGrp> grp = it->second;
+        lock.unlock();
+        grp->Clear();
     }
     else {
 #endif
@@ -902,6 +919,8 @@ void ParameterGrp::RemoveGrp(const char* Name)
 #if 1
     }
 #endif
+    if (lock.owns_lock())
+        lock.unlock();
 
     // trigger observer
     Notify(Name);
@@ -909,6 +928,7 @@ void ParameterGrp::RemoveGrp(const char* Name)
 
 bool ParameterGrp::RenameGrp(const char* OldName, const char* NewName)
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     auto it = _GroupMap.find(OldName);
     if (it == _GroupMap.end())
         return false;
@@ -931,15 +951,17 @@ bool ParameterGrp::RenameGrp(const char* OldName, const char* NewName)
 
 void ParameterGrp::Clear(void)
 {
+    std::unique_lock<std::recursive_mutex> lock(_ParameterMutex);
     std::vector<DOMNode*> vecNodes;
 
     // checking on references
     std::vector<std::string> removeGrp;
+    std::vector<Base::Reference<ParameterGrp> > clearGrp;
     for (auto it = _GroupMap.begin();it!=_GroupMap.end();++it) {
         // If a group is referenced by some observer then do not remove it
         // but clear it
         if (!it->second->ShouldRemove()) {
-            it->second->Clear();
+            clearGrp.push_back(it->second);
         }
         else {
             removeGrp.push_back(it->first);
@@ -964,6 +986,11 @@ void ParameterGrp::Clear(void)
         DOMNode *child = _pGroupNode->removeChild(*it);
         child->release();
     }
+    lock.unlock();
+
+    // the referenced sub-groups notify their own observers
+    for (auto &grp : clearGrp)
+        grp->Clear();
 
     // trigger observer
     Notify("");
@@ -1049,6 +1076,74 @@ XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindOrCreateElement(XER
     return pcElem;
 }
 
+/// immutable copy of all values of a group, see ParameterGrp::GetValues()
+struct ParameterGrp::ValueSnapshot {
+    std::unordered_map<std::string, bool> Bools;
+    std::unordered_map<std::string, long> Ints;
+    std::unordered_map<std::string, unsigned long> Unsigneds;
+    std::unordered_map<std::string, double> Floats;
+    std::unordered_map<std::string, std::string> ASCIIs;
+};
+
+std::recursive_mutex ParameterGrp::_ParameterMutex;
+
+std::shared_ptr<const ParameterGrp::ValueSnapshot> ParameterGrp::GetValues() const
+{
+    // readers only load the published snapshot, so there is no need to lock
+    std::shared_ptr<const ValueSnapshot> values = std::atomic_load(&_Values);
+    if (values)
+        return values;
+
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
+    values = std::atomic_load(&_Values);
+    if (values)
+        return values;
+
+    std::shared_ptr<ValueSnapshot> snapshot = std::make_shared<ValueSnapshot>();
+    for (DOMNode *clChild = _pGroupNode ? _pGroupNode->getFirstChild() : 0; clChild != 0;  clChild = clChild->getNextSibling()) {
+        if (clChild->getNodeType() != DOMNode::ELEMENT_NODE || clChild->getAttributes()->getLength() == 0)
+            continue;
+        DOMElement *pcElem = static_cast<DOMElement*>(clChild);
+        std::string Type = StrX(pcElem->getNodeName()).c_str();
+        std::string Name = StrX(pcElem->getAttribute(XStr("Name").unicodeForm())).c_str();
+        // as with FindElement() the first element of a name wins
+        if (Type == "FCBool") {
+            snapshot->Bools.emplace(Name, !strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"));
+        }
+        else if (Type == "FCInt") {
+            snapshot->Ints.emplace(Name, atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str()));
+        }
+        else if (Type == "FCUInt") {
+            snapshot->Unsigneds.emplace(Name, strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10));
+        }
+        else if (Type == "FCFloat") {
+            snapshot->Floats.emplace(Name, atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str()));
+        }
+        else if (Type == "FCText") {
+            DOMNode *pcElem2 = pcElem->getFirstChild();
+            if (pcElem2)
+                snapshot->ASCIIs.emplace(Name, StrXUTF8(pcElem2->getNodeValue()).c_str());
+        }
+    }
+
+    values = snapshot;
+    std::atomic_store(&_Values, values);
+    return values;
+}
+
+void ParameterGrp::Notify(const char* Name)
+{
+    ClearCache();
+
+    // trigger observer
+    Subject<const char*>::Notify(Name);
+}
+
+void ParameterGrp::ClearCache()
+{
+    std::atomic_store(&_Values, std::shared_ptr<const ValueSnapshot>());
+}
+
 void ParameterGrp::NotifyAll()
 {
     // get all ints and notify
@@ -1295,6 +1390,7 @@ int  ParameterManager::LoadDocument(const char* sFileName)
 
 int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSource& inputSource)
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     //
     //  Create our parser, then attach an error handler to the parser.
     //  The parser will call back to methods of the ErrorHandler if it
@@ -1354,6 +1450,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
         throw XMLBaseException("Malformed Parameter document: Root group not found");
 
     _pGroupNode = FindElement(rootElem,"FCParamGroup","Root");
+    ClearCache();
 
     if (!_pGroupNode)
         throw XMLBaseException("Malformed Parameter document: Root group not found");
@@ -1390,6 +1487,8 @@ void  ParameterManager::SaveDocument(const char* sFileName) const
 
 void  ParameterManager::SaveDocument(XMLFormatTarget* pFormatTarget) const
 {
+    // the print filter modifies the DOM
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
 #if (XERCES_VERSION_MAJOR == 2)
     DOMPrintFilter   *myFilter = 0;
 
@@ -1520,6 +1619,7 @@ void  ParameterManager::SaveDocument(XMLFormatTarget* pFormatTarget) const
 
 void  ParameterManager::CreateDocument(void)
 {
+    std::lock_guard<std::recursive_mutex> lock(_ParameterMutex);
     // creating a document from screatch
     DOMImplementation* impl =  DOMImplementationRegistry::getDOMImplementation(XStr("Core").unicodeForm());
     delete _pDocument;
@@ -1533,6 +1633,7 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     static_cast<DOMElement*>(_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    ClearCache();
 }
 
 void  ParameterManager::CheckDocument() const
@@ -58,6 +58,9 @@
 #endif
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -236,6 +239,10 @@ public:
     /** Notifies all observers for all entries except of sub-groups.
      */
     void NotifyAll();
+    /** Notifies all observers about a change of the entry \a Name.
+     *  This also drops the cached values of this group.
+     */
+    void Notify(const char* Name);
 
 protected:
     /// constructor is protected (handle concept)
@@ -263,6 +270,9 @@ protected:
      */
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
+    /// drop all cached values of this group
+    void ClearCache();
+
 
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
@@ -271,6 +281,25 @@ protected:
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
 
+    /** @name Value snapshot
+     *  GetBool(), GetInt(), GetUnsigned(), GetFloat() and GetASCII() read from
+     *  an immutable copy of all values of the group, so that repeated reads do
+     *  not need to search and transcode the DOM again. The snapshot is
+     *  published atomically, so these getters can be called from worker
+     *  threads without locking. Notify(), which is called on every
+     *  modification, drops the snapshot and the next read builds a new one.
+     *
+     *  All access to the DOM, i.e. every modification and building a
+     *  snapshot, is serialized by _ParameterMutex. Observers are notified
+     *  after the lock is released.
+     */
+    //@{
+    struct ValueSnapshot;
+    std::shared_ptr<const ValueSnapshot> GetValues() const;
+    mutable std::shared_ptr<const ValueSnapshot> _Values;
+    static std::recursive_mutex _ParameterMutex;
+    //@}
+
 };
 
 /** The parameter serializer class
@@ -1093,6 +1093,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
         temp.log(false,clearPreselect);
 
     _SelList.push_back(temp);
+    addSelIndex(temp);
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1257,6 +1258,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.z        = 0;
 
         _SelList.push_back(temp);
+        addSelIndex(temp);
         _SelStackForward.clear();
 
         SelectionChanges Chng(SelectionChanges::AddSelection,
@@ -1273,6 +1275,68 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
     return true;
 }
 
+std::size_t SelectionSingleton::addSelections(const std::vector<App::SubObjectT>& objs)
+{
+    if(_PickedList.size()) {
+        _PickedList.clear();
+        notify(SelectionChanges(SelectionChanges::PickedListChanged));
+    }
+
+    std::set<std::string> docs;
+    std::size_t count = 0;
+    bool rejected = false;
+    for(auto &obj : objs) {
+        _SelObj temp;
+        int ret = checkSelection(obj.getDocumentName().c_str(),
+                obj.getObjectName().c_str(),obj.getSubName().c_str(),0,temp);
+        if(ret!=0)
+            continue;
+
+        // check for a Selection Gate
+        if (ActiveGate) {
+            const char *subelement = 0;
+            auto pObject = getObjectOfType(temp,App::DocumentObject::getClassTypeId(),gateResolve,&subelement);
+            if (!ActiveGate->allow(pObject?pObject->getDocument():temp.pDoc,pObject,subelement)) {
+                rejected = true;
+                continue;
+            }
+        }
+
+        if(!logDisabled)
+            temp.log();
+
+        _SelList.push_back(temp);
+        addSelIndex(temp);
+        docs.insert(temp.DocName);
+        ++count;
+    }
+
+    if (rejected) {
+        if (getMainWindow()) {
+            QString msg;
+            if (ActiveGate->notAllowedReason.length() > 0) {
+                msg = QObject::tr(ActiveGate->notAllowedReason.c_str());
+            } else {
+                msg = QCoreApplication::translate("SelectionFilter","Selection not allowed by filter");
+            }
+            getMainWindow()->showMessage(msg);
+        }
+        ActiveGate->notAllowedReason.clear();
+        QApplication::beep();
+    }
+
+    // Send one notification per document instead of one per entry
+    if(count) {
+        _SelStackForward.clear();
+        for(auto &docName : docs) {
+            FC_LOG("Set Selection "<<docName<<" ("<<count<<" added)");
+            notify(SelectionChanges(SelectionChanges::SetSelection,docName.c_str()));
+        }
+        getMainWindow()->updateActions();
+    }
+    return count;
+}
+
 bool SelectionSingleton::updateSelection(bool show, const char* pDocName, 
                             const char* pObjectName, const char* pSubName)
 {
@@ -1381,6 +1445,7 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
+        rmvSelIndex(*It);
         _SelList.erase(It);
     }
 
@@ -1495,6 +1560,64 @@ void SelectionSingleton::setVisible(VisibleState vis) {
     }
 }
 
+std::size_t SelectionSingleton::rmvSelections(const std::vector<App::SubObjectT>& objs)
+{
+    if(_PickedList.size()) {
+        _PickedList.clear();
+        notify(SelectionChanges(SelectionChanges::PickedListChanged));
+    }
+
+    // subnames to remove by document and object name
+    std::map<std::pair<std::string,std::string>, std::vector<std::string> > subMap;
+    for(auto &obj : objs) {
+        _SelObj temp;
+        if(checkSelection(obj.getDocumentName().c_str(),
+                obj.getObjectName().c_str(),obj.getSubName().c_str(),0,temp)<0)
+            continue;
+        subMap[std::make_pair(temp.DocName,temp.FeatName)].push_back(temp.SubName);
+    }
+    if(subMap.empty())
+        return 0;
+
+    std::set<std::string> docs;
+    std::size_t count = 0;
+    for(auto it=_SelList.begin();it!=_SelList.end();) {
+        auto iter = subMap.find(std::make_pair(it->DocName,it->FeatName));
+        bool found = false;
+        if(iter != subMap.end()) {
+            for(auto &sub : iter->second) {
+                // same matching as rmvSelection()
+                if(sub.empty() || (boost::starts_with(it->SubName,sub) &&
+                   (it->SubName.length()==sub.length() || it->SubName[sub.length()-1]=='.')))
+                {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if(!found) {
+            ++it;
+            continue;
+        }
+        if(!logDisabled)
+            it->log(true);
+        docs.insert(it->DocName);
+        rmvSelIndex(*it);
+        it = _SelList.erase(it);
+        ++count;
+    }
+
+    if(count) {
+        _SelStackForward.clear();
+        for(auto &docName : docs) {
+            FC_LOG("Set Selection "<<docName<<" ("<<count<<" removed)");
+            notify(SelectionChanges(SelectionChanges::SetSelection,docName.c_str()));
+        }
+        getMainWindow()->updateActions();
+    }
+    return count;
+}
+
 void SelectionSingleton::setSelection(const char* pDocName, const std::vector<App::DocumentObject*>& sel)
 {
     App::Document *pcDoc;
@@ -1517,6 +1640,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
             continue;
         touched = true;
         _SelList.push_back(temp);
+        addSelIndex(temp);
     }
 
     if(touched) {
@@ -1552,6 +1676,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
         for (auto it=_SelList.begin();it!=_SelList.end();) {
             if (it->DocName == docName) {
                 touched = true;
+                rmvSelIndex(*it);
                 it = _SelList.erase(it);
             }
             else {
@@ -1596,6 +1721,7 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
                               :"Gui.Selection.clearSelection(False)");
 
     _SelList.clear();
+    clearSelIndex();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
@@ -1678,6 +1804,19 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     if(!pSubName)
         pSubName = "";
 
+    if(selList == &_SelList) {
+        // Use the index to avoid scanning the list in the common case
+        if(_SelIndex.count(selIndexKey(sel.DocName,sel.FeatName,pSubName)))
+            return 1;
+        bool found = false;
+        if(resolve>1 && _SelObjIndex.count(selIndexKey(sel.DocName,sel.FeatName)))
+            found = true;
+        else if(resolve==1 && _SelResolvedIndex.count(sel.pResolvedObject))
+            found = true;
+        if(!found)
+            return 0;
+    }
+
     for (auto &s : *selList) {
         if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
             if(s.SubName==pSubName)
@@ -1702,6 +1841,48 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     return 0;
 }
 
+std::string SelectionSingleton::selIndexKey(const std::string &docName,
+        const std::string &objName, const char *subName)
+{
+    std::string key;
+    key.reserve(docName.size()+objName.size()+(subName?strlen(subName)+2:1));
+    key += docName;
+    key += '#';
+    key += objName;
+    if(subName) {
+        key += '.';
+        key += subName;
+    }
+    return key;
+}
+
+void SelectionSingleton::addSelIndex(const _SelObj &sel)
+{
+    ++_SelIndex[selIndexKey(sel.DocName,sel.FeatName,sel.SubName.c_str())];
+    ++_SelObjIndex[selIndexKey(sel.DocName,sel.FeatName)];
+    ++_SelResolvedIndex[sel.pResolvedObject];
+}
+
+void SelectionSingleton::rmvSelIndex(const _SelObj &sel)
+{
+    auto it = _SelIndex.find(selIndexKey(sel.DocName,sel.FeatName,sel.SubName.c_str()));
+    if(it!=_SelIndex.end() && --it->second<=0)
+        _SelIndex.erase(it);
+    auto itObj = _SelObjIndex.find(selIndexKey(sel.DocName,sel.FeatName));
+    if(itObj!=_SelObjIndex.end() && --itObj->second<=0)
+        _SelObjIndex.erase(itObj);
+    auto itRes = _SelResolvedIndex.find(sel.pResolvedObject);
+    if(itRes!=_SelResolvedIndex.end() && --itRes->second<=0)
+        _SelResolvedIndex.erase(itRes);
+}
+
+void SelectionSingleton::clearSelIndex()
+{
+    _SelIndex.clear();
+    _SelObjIndex.clear();
+    _SelResolvedIndex.clear();
+}
+
 const char *SelectionSingleton::getSelectedElement(App::DocumentObject *obj, const char* pSubName) const 
 {
     if (!obj) return 0;
@@ -1735,6 +1916,7 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
         if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
             changes.emplace_back(SelectionChanges::RmvSelection,
                     it->DocName,it->FeatName,it->SubName,it->TypeName);
+            rmvSelIndex(*it);
             _SelList.erase(it);
         }
     }
@@ -1954,13 +2136,15 @@ PyObject *SelectionSingleton::sAddSelection(PyObject * /*self*/, PyObject *args)
 
         try {
             if (PyTuple_Check(sequence) || PyList_Check(sequence)) {
+                std::vector<App::SubObjectT> sels;
                 Py::Sequence list(sequence);
                 for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
                     std::string subname = static_cast<std::string>(Py::String(*it));
-                    Selection().addSelection(docObj->getDocument()->getName(),
-                                             docObj->getNameInDocument(),
-                                             subname.c_str(),0,0,0,0,PyObject_IsTrue(clearPreselect));
+                    sels.emplace_back(docObj, subname.c_str());
                 }
+                if (PyObject_IsTrue(clearPreselect))
+                    Selection().rmvPreselect();
+                Selection().addSelections(sels);
 
                 Py_Return;
             }
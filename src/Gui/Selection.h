@@ -30,6 +30,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <deque>
 #include <boost/signals2.hpp>
 #include <CXX/Objects.hxx>
@@ -376,6 +377,25 @@ public:
     bool addSelection(const SelectionObject&, bool clearPreSelect=true);
     /// Add to selection with several sub-elements
     bool addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
+    /** Add a batch of (sub-)objects to the selection
+     *
+     * In contrast to addSelection() only a single SelectionChanges::SetSelection
+     * notification is sent for each affected document, which makes it suitable
+     * for large selections like box-selecting thousands of sub-elements. The
+     * active selection gate is respected, and each entry is recorded as
+     * Gui.Selection.addSelection() unless logging is disabled.
+     * @return the number of newly added entries.
+     */
+    std::size_t addSelections(const std::vector<App::SubObjectT>& objs);
+    /** Remove a batch of (sub-)objects from the selection
+     *
+     * Matches like rmvSelection(), i.e. an object without subname removes all
+     * its sub-objects, and a subname ending with '.' removes all entries
+     * below it. A single SelectionChanges::SetSelection notification is sent
+     * for each affected document.
+     * @return the number of removed entries.
+     */
+    std::size_t rmvSelections(const std::vector<App::SubObjectT>& objs);
     /// Update a selection 
     bool updateSelection(bool show, const char* pDocName, const char* pObjectName=0, const char* pSubName=0);
     /// Remove from selection (for internal use)
@@ -702,6 +722,22 @@ protected:
     };
     mutable std::list<_SelObj> _SelList;
 
+    /** Hashed index of _SelList used by checkSelection()
+     * The maps hold the number of entries in _SelList with the given key
+     * so that the common case of a non-selected object is answered without
+     * scanning the list. They must be kept in sync with any change of _SelList.
+     */
+    //@{
+    std::unordered_map<std::string, int> _SelIndex;       // 'doc#obj.sub'
+    std::unordered_map<std::string, int> _SelObjIndex;    // 'doc#obj'
+    std::unordered_map<const App::DocumentObject*, int> _SelResolvedIndex;
+    static std::string selIndexKey(const std::string &docName,
+            const std::string &objName, const char *subName=0);
+    void addSelIndex(const _SelObj &sel);
+    void rmvSelIndex(const _SelObj &sel);
+    void clearSelIndex();
+    //@}
+
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList;
 
@@ -86,6 +86,21 @@ std::unique_ptr<QPixmap>  TreeWidget::documentPixmap;
 std::unique_ptr<QPixmap>  TreeWidget::documentPartialPixmap;
 std::set<TreeWidget *> TreeWidget::Instances;
 static TreeWidget *_LastSelectedTreeWidget;
+
+// Selection changes collected by DocumentItem::updateItemSelection() while
+// several tree items change their selection at once (e.g. box selection).
+// They are applied with Selection().rmvSelections()/addSelections() by
+// TreeWidget::onItemSelectionChanged().
+struct SelectionBatch {
+    struct Entry {
+        DocumentObjectItem *item;
+        App::SubObjectT sobj;
+        std::vector<std::string> subs;
+    };
+    std::vector<App::SubObjectT> removals;
+    std::vector<Entry> entries;
+};
+static SelectionBatch *_SelectionBatch;
 const int TreeWidget::DocumentType = 1000;
 const int TreeWidget::ObjectType = 1001;
 bool _DragEventFilter;
@@ -2543,6 +2558,9 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
         DocumentObjectItem* objItem = static_cast<DocumentObjectItem*>(item);
         objItem->setExpandedStatus(true);
         objItem->getOwnerDocument()->populateItem(objItem,false,false);
+        // Status of children under collapsed item is not updated in onUpdateStatus()
+        std::unordered_map<DocumentObjectData*, std::pair<QIcon,QIcon> > icons;
+        objItem->getOwnerDocument()->testStatus(objItem,icons);
     }
 }
 
@@ -2760,11 +2778,64 @@ void TreeWidget::onItemSelectionChanged ()
         if(TreeParams::Instance()->RecordSelection())
             Gui::Selection().selStackPush();
     }else{
+        SelectionBatch batch;
+        _SelectionBatch = &batch;
         for (auto pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
             currentDocItem = pos->second;
             pos->second->updateSelection(pos->second);
             currentDocItem = 0;
         }
+        _SelectionBatch = 0;
+
+        Selection().rmvSelections(batch.removals);
+        std::vector<App::SubObjectT> sels;
+        for(auto &entry : batch.entries) {
+            if(entry.subs.empty())
+                sels.push_back(entry.sobj);
+            for(auto &sub : entry.subs)
+                sels.emplace_back(entry.sobj.getDocumentName().c_str(),
+                        entry.sobj.getObjectName().c_str(),
+                        (entry.sobj.getSubName()+sub).c_str());
+        }
+        Selection().addSelections(sels);
+
+        // Same as DocumentItem::updateItemSelection(), fall back to the whole
+        // object if none of the remembered sub-elements can be selected, and
+        // unselect the item if that fails, too.
+        sels.clear();
+        for(auto &entry : batch.entries) {
+            bool selected = false;
+            for(auto &sub : entry.subs) {
+                if(Selection().isSelected(entry.sobj.getDocumentName().c_str(),
+                            entry.sobj.getObjectName().c_str(),
+                            (entry.sobj.getSubName()+sub).c_str(),0))
+                {
+                    selected = true;
+                    break;
+                }
+            }
+            if(!selected && entry.subs.size()) {
+                entry.item->mySubs.clear();
+                entry.subs.clear();
+                sels.push_back(entry.sobj);
+            }
+        }
+        Selection().addSelections(sels);
+
+        DocumentObjectItem *lastItem = 0;
+        for(auto &entry : batch.entries) {
+            if(entry.subs.empty() && !Selection().isSelected(entry.sobj.getDocumentName().c_str(),
+                        entry.sobj.getObjectName().c_str(), entry.sobj.getSubName().c_str(),0))
+            {
+                entry.item->selected = 0;
+                entry.item->setSelected(false);
+                continue;
+            }
+            lastItem = entry.item;
+        }
+        if(lastItem)
+            syncView(lastItem->object());
+
         if(TreeParams::Instance()->RecordSelection())
             Gui::Selection().selStackPush(true,true);
     }
@@ -3871,8 +3942,27 @@ Gui::Document* DocumentItem::document() const
 
 void DocumentItem::testStatus(void)
 {
-    for(const auto &v : ObjectMap)
-        v.second->testStatus();
+    // Only check the items that can be seen, i.e. the top level items and the
+    // children of expanded items. The others are checked when their parent
+    // item is expanded, see TreeWidget::onItemExpanded().
+    std::unordered_map<DocumentObjectData*, std::pair<QIcon,QIcon> > icons;
+    testStatus(this,icons);
+}
+
+void DocumentItem::testStatus(QTreeWidgetItem *parent,
+        std::unordered_map<DocumentObjectData*, std::pair<QIcon,QIcon> > &icons)
+{
+    for(int i=0,count=parent->childCount();i<count;++i) {
+        auto child = parent->child(i);
+        if(child->type() != TreeWidget::ObjectType)
+            continue;
+        auto item = static_cast<DocumentObjectItem*>(child);
+        // Items of the same object share the same icon
+        auto &icon = icons[item->myData.get()];
+        item->testStatus(false,icon.first,icon.second);
+        if(item->isExpanded())
+            testStatus(item,icons);
+    }
 }
 
 void DocumentItem::setData (int column, int role, const QVariant & value)
@@ -3945,8 +4035,11 @@ void DocumentItem::updateItemSelection(DocumentObjectItem *item) {
     if(topParent) {
         if(topParent->hasExtension(App::GeoFeatureGroupExtension::getExtensionClassTypeId())) {
             // remove legacy selection, i.e. those without subname
-            Gui::Selection().rmvSelection(obj->getDocument()->getName(),
-                    obj->getNameInDocument(),0);
+            if(_SelectionBatch)
+                _SelectionBatch->removals.emplace_back(obj,"");
+            else
+                Gui::Selection().rmvSelection(obj->getDocument()->getName(),
+                        obj->getNameInDocument(),0);
         }
         if(!obj->redirectSubName(str,topParent,0))
             str << obj->getNameInDocument() << '.';
@@ -3988,7 +4081,19 @@ void DocumentItem::updateItemSelection(DocumentObjectItem *item) {
     }
 
     if(!selected) {
-        Gui::Selection().rmvSelection(docname,objname,subname.c_str());
+        if(_SelectionBatch)
+            _SelectionBatch->removals.emplace_back(docname,objname,subname.c_str());
+        else
+            Gui::Selection().rmvSelection(docname,objname,subname.c_str());
+        return;
+    }
+    if(_SelectionBatch) {
+        // selected together with the other items, see TreeWidget::onItemSelectionChanged()
+        _SelectionBatch->entries.emplace_back();
+        auto &entry = _SelectionBatch->entries.back();
+        entry.item = item;
+        entry.sobj = App::SubObjectT(docname,objname,subname.c_str());
+        entry.subs.assign(item->mySubs.begin(),item->mySubs.end());
         return;
     }
     selected = false;
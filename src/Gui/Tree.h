@@ -285,6 +285,8 @@ public:
     void selectItems(SelectionReason reason=SR_SELECT);
 
     void testStatus(void);
+    void testStatus(QTreeWidgetItem *parent,
+            std::unordered_map<DocumentObjectData*, std::pair<QIcon,QIcon> > &icons);
     void setData(int column, int role, const QVariant & value) override;
     void populateItem(DocumentObjectItem *item, bool refresh=false, bool delayUpdate=true);
     bool populateObject(App::DocumentObject *obj);
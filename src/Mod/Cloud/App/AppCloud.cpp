@@ -1214,7 +1214,7 @@ bool Cloud::Module::cloudSave(const char *BucketName)
 
         mywriter.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false))
+        if (hGrp->GetBool("SaveBinaryBrep", true))
             mywriter.setMode("BinaryBrep");
         mywriter.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
                         << "<!--" << endl
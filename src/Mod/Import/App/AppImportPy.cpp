@@ -114,7 +114,8 @@ public:
 //            "openAssembly(string) -- Open the assembly file and create a new document."
 //        );
         add_keyword_method("export",&Module::exporter,
-            "export(list,string) -- Export a list of objects into a single file."
+            "export(list,string,[colors]) -- Export a list of objects into a single file.\n"
+            "colors maps object names to dicts of element colors, e.g. {'Box':{'Face1':(1.0,0.0,0.0)}}."
         );
          add_varargs_method("readDXF",&Module::readDXF,
             "readDXF(filename,[document,ignore_errors]): Imports a DXF file into the given document. ignore_errors is True by default."
@@ -139,9 +140,12 @@ private:
         PyObject *merge = Py_None;
         PyObject *useLinkGroup = Py_None;
         int mode = -1;
-        static char* kwd_list[] = {"name", "docName","importHidden","merge","useLinkGroup","mode",0};
-        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "et|sOOOi", 
-                    kwd_list,"utf-8",&Name,&DocName,&importHidden,&merge,&useLinkGroup,&mode))
+        PyObject *parallelColors = Py_None;
+        static char* kwd_list[] = {"name", "docName","importHidden","merge","useLinkGroup","mode",
+                                   "parallelColors",0};
+        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "et|sOOOiO", 
+                    kwd_list,"utf-8",&Name,&DocName,&importHidden,&merge,&useLinkGroup,&mode,
+                    &parallelColors))
             throw Py::Exception();
 
         std::string Utf8Name = std::string(Name);
@@ -238,6 +242,8 @@ private:
                 ocaf.setUseLinkGroup(PyObject_IsTrue(useLinkGroup));
             if (mode >= 0)
                 ocaf.setMode(mode);
+            if (parallelColors != Py_None)
+                ocaf.setParallelColors(PyObject_IsTrue(parallelColors));
             ocaf.loadShapes();
 #elif 1
             Import::ImportOCAFCmd ocaf(hDoc, pcDoc, file.fileNamePure());
@@ -281,9 +287,10 @@ private:
         PyObject *exportHidden = Py_None;
         PyObject *legacy = Py_None;
         PyObject *keepPlacement = Py_None;
-        static char* kwd_list[] = {"obj", "name", "exportHidden", "legacy", "keepPlacement",0};
-        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Oet|OOO",
-                    kwd_list,&object,"utf-8",&Name,&exportHidden,&legacy,&keepPlacement))
+        PyObject *colors = Py_None;
+        static char* kwd_list[] = {"obj", "name", "exportHidden", "legacy", "keepPlacement", "colors",0};
+        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Oet|OOOO",
+                    kwd_list,&object,"utf-8",&Name,&exportHidden,&legacy,&keepPlacement,&colors))
             throw Py::Exception();
 
         std::string Utf8Name = std::string(Name);
@@ -309,7 +316,40 @@ private:
                 legacy = hGrp->GetBool("ExportLegacy",false)?Py_True:Py_False;
             }
 
-            Import::ExportOCAF2 ocaf(hDoc);
+            // Without view providers, the element colors can only be given
+            // explicitly, keyed by object name and then element name
+            std::map<std::string, std::map<std::string,App::Color> > shapeColors;
+            if (colors != Py_None) {
+                Py::Dict dict(colors);
+                for (auto it = dict.begin(); it != dict.end(); ++it) {
+                    auto &elementColors = shapeColors[Py::String((*it).first).as_std_string()];
+                    Py::Dict elements((*it).second);
+                    for (auto jt = elements.begin(); jt != elements.end(); ++jt) {
+                        App::PropertyColor color;
+                        color.setPyObject((*jt).second.ptr());
+                        elementColors[Py::String((*jt).first).as_std_string()] = color.getValue();
+                    }
+                }
+            }
+            auto getShapeColors = [&shapeColors](App::DocumentObject *obj, const char *subname) {
+                std::map<std::string,App::Color> res;
+                auto it = shapeColors.find(obj->getNameInDocument());
+                if (it == shapeColors.end())
+                    return res;
+                // subname is a pattern such as "Face*"
+                std::string prefix(subname);
+                if (prefix.size() && prefix[prefix.size()-1] == '*')
+                    prefix.resize(prefix.size()-1);
+                for (auto &v : it->second) {
+                    if (v.first.compare(0,prefix.size(),prefix) == 0)
+                        res.insert(v);
+                }
+                return res;
+            };
+
+            Import::ExportOCAF2 ocaf(hDoc, shapeColors.empty() ?
+                    Import::ExportOCAF2::GetShapeColorsFunc() :
+                    Import::ExportOCAF2::GetShapeColorsFunc(getShapeColors));
             if(!PyObject_IsTrue(legacy) || !ocaf.canFallback(objs)) {
                 if(exportHidden!=Py_None)
                     ocaf.setExportHiddenObject(PyObject_IsTrue(exportHidden));
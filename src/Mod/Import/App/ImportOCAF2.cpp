@@ -46,8 +46,12 @@
 # include <Interface_Static.hxx>
 # include <TDF_AttributeSequence.hxx>
 # include <TopTools_MapOfShape.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <algorithm>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <XCAFDoc_ShapeMapTool.hxx>
 
 #include <boost/regex.hpp>
@@ -56,6 +60,7 @@
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
 #include <App/Application.h>
+#include <App/AutoTransaction.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
 #include <App/Part.h>
@@ -158,6 +163,7 @@ ImportOCAF2::ImportOCAF2(Handle(TDocStd_Document) h, App::Document* d, const std
     reduceObjects = hGrp->GetBool("ReduceObjects",true);
     showProgress = hGrp->GetBool("ShowProgress",true);
     expandCompound = hGrp->GetBool("ExpandCompound",true);
+    parallelColors = hGrp->GetBool("ParallelColors",true);
 
     if(d->isSaved()) {
         Base::FileInfo fi(d->FileName.getValue());
@@ -332,79 +338,27 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
     }
 
     getColor(shape,info);
-    bool hasFaceColors = false;
-    bool hasEdgeColors = false;
 
     Part::TopoShape tshape(shape);
-    std::vector<App::Color> faceColors;
-    std::vector<App::Color> edgeColors;
-
-    TDF_LabelSequence seq;
-    if(!label.IsNull() && aShapeTool->GetSubShapes(label,seq)) {
-
-        TopTools_IndexedMapOfShape faceMap,edgeMap;
-        TopExp::MapShapes(tshape.getShape(), TopAbs_FACE, faceMap);
-        TopExp::MapShapes(tshape.getShape(), TopAbs_EDGE, edgeMap);
-
-        faceColors.assign(faceMap.Extent(),info.faceColor);
-        edgeColors.assign(edgeMap.Extent(),info.edgeColor);
-        // Two passes to get sub shape colors. First pass, look for solid, and
-        // second pass look for face and edges. This allows lower level
-        // subshape to override color of higher level ones.
-        for(int j=0;j<2;++j) {
-            for(int i=1;i<=seq.Length();++i) {
-                TDF_Label l = seq.Value(i);
-                TopoDS_Shape subShape = aShapeTool->GetShape(l);
-                if(subShape.IsNull())
-                    continue;
-                if(subShape.ShapeType()==TopAbs_FACE || subShape.ShapeType()==TopAbs_EDGE) {
-                    if(j==0)
-                        continue;
-                }else if(j!=0)
-                    continue;
-
-                bool foundFaceColor=false,foundEdgeColor=false;
-                App::Color faceColor,edgeColor;
-                Quantity_Color aColor;
-                if(aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor) ||
-                   aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor))
-                {
-                    faceColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
-                    foundFaceColor = true;
-                }
-                if(aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
-                    edgeColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
-                    foundEdgeColor = true;
-                    if(j==0 && foundFaceColor && faceColors.size() && edgeColor==faceColor) {
-                        // Do not set edge the same color as face
-                        foundEdgeColor = false;
-                    }
-                }
 
-                if(foundFaceColor) {
-                    for(TopExp_Explorer exp(subShape,TopAbs_FACE);exp.More();exp.Next()) {
-                        int idx = faceMap.FindIndex(exp.Current())-1;
-                        if(idx>=0 && idx<(int)faceColors.size()) {
-                            faceColors[idx] = faceColor;
-                            hasFaceColors = true;
-                            info.hasFaceColor = true;
-                        }else
-                            assert(0);
-                    }
-                }
-                if(foundEdgeColor) {
-                    for(TopExp_Explorer exp(subShape,TopAbs_EDGE);exp.More();exp.Next()) {
-                        int idx = edgeMap.FindIndex(exp.Current())-1;
-                        if(idx>=0 && idx<(int)edgeColors.size()) {
-                            edgeColors[idx] = edgeColor;
-                            hasEdgeColors = true;
-                            info.hasEdgeColor = true;
-                        }
-                    }
-                }
-            }
-        }
+    ShapeColors colors;
+    auto itColor = label.IsNull()?myColors.end():myColors.find(label);
+    if(itColor!=myColors.end() && itColor->second.shape.IsEqual(shape)) {
+        colors = std::move(itColor->second);
+        myColors.erase(itColor);
+    } else {
+        std::vector<SubShapeColor> subs;
+        if(getSubShapeColors(label,subs))
+            mapSubShapeColors(shape,info,subs,colors);
     }
+    bool hasFaceColors = colors.hasFaceColors;
+    bool hasEdgeColors = colors.hasEdgeColors;
+    auto &faceColors = colors.faceColors;
+    auto &edgeColors = colors.edgeColors;
+    if(hasFaceColors)
+        info.hasFaceColor = true;
+    if(hasEdgeColors)
+        info.hasEdgeColor = true;
 
     Part::Feature *feature;
 
@@ -434,6 +388,137 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
     return true;
 }
 
+bool ImportOCAF2::getSubShapeColors(TDF_Label label, std::vector<SubShapeColor> &subs) {
+    TDF_LabelSequence seq;
+    if(label.IsNull() || !aShapeTool->GetSubShapes(label,seq))
+        return false;
+    for(int i=1;i<=seq.Length();++i) {
+        TDF_Label l = seq.Value(i);
+        SubShapeColor sub;
+        sub.shape = aShapeTool->GetShape(l);
+        if(sub.shape.IsNull())
+            continue;
+        Quantity_Color aColor;
+        if(aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor) ||
+           aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor))
+        {
+            sub.faceColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
+            sub.hasFaceColor = true;
+        }
+        if(aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
+            sub.edgeColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
+            sub.hasEdgeColor = true;
+        }
+        subs.push_back(sub);
+    }
+    return true;
+}
+
+// This function only accesses the given shapes without touching the OCAF
+// document, so that it can be run in worker threads.
+void ImportOCAF2::mapSubShapeColors(const TopoDS_Shape &shape, const Info &info,
+        const std::vector<SubShapeColor> &subs, ShapeColors &colors)
+{
+    TopTools_IndexedMapOfShape faceMap,edgeMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+
+    auto &faceColors = colors.faceColors;
+    auto &edgeColors = colors.edgeColors;
+    faceColors.assign(faceMap.Extent(),info.faceColor);
+    edgeColors.assign(edgeMap.Extent(),info.edgeColor);
+    // Two passes to get sub shape colors. First pass, look for solid, and
+    // second pass look for face and edges. This allows lower level
+    // subshape to override color of higher level ones.
+    for(int j=0;j<2;++j) {
+        for(auto &sub : subs) {
+            const TopoDS_Shape &subShape = sub.shape;
+            if(subShape.ShapeType()==TopAbs_FACE || subShape.ShapeType()==TopAbs_EDGE) {
+                if(j==0)
+                    continue;
+            }else if(j!=0)
+                continue;
+
+            bool foundEdgeColor = sub.hasEdgeColor;
+            if(foundEdgeColor && j==0 && sub.hasFaceColor 
+                    && faceColors.size() && sub.edgeColor==sub.faceColor) {
+                // Do not set edge the same color as face
+                foundEdgeColor = false;
+            }
+
+            if(sub.hasFaceColor) {
+                for(TopExp_Explorer exp(subShape,TopAbs_FACE);exp.More();exp.Next()) {
+                    int idx = faceMap.FindIndex(exp.Current())-1;
+                    if(idx>=0 && idx<(int)faceColors.size()) {
+                        faceColors[idx] = sub.faceColor;
+                        colors.hasFaceColors = true;
+                    }else
+                        assert(0);
+                }
+            }
+            if(foundEdgeColor) {
+                for(TopExp_Explorer exp(subShape,TopAbs_EDGE);exp.More();exp.Next()) {
+                    int idx = edgeMap.FindIndex(exp.Current())-1;
+                    if(idx>=0 && idx<(int)edgeColors.size()) {
+                        edgeColors[idx] = sub.edgeColor;
+                        colors.hasEdgeColors = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ImportOCAF2::prepareShapeColors(const TDF_LabelSequence &labels) {
+    myColors.clear();
+
+    struct Job {
+        TDF_Label label;
+        Info info;
+        std::vector<SubShapeColor> subs;
+        ShapeColors colors;
+    };
+
+    // Query the OCAF document in the current thread, and then map the sub
+    // shape colors to face and edge indices (which requires exploring the
+    // whole shape) in parallel.
+    std::vector<Job> jobs;
+    for (Standard_Integer i=1; i <= labels.Length(); i++ ) {
+        auto label = labels.Value(i);
+        if(aShapeTool->IsAssembly(label))
+            continue;
+        Job job;
+        if(!getSubShapeColors(label,job.subs) || job.subs.empty())
+            continue;
+        job.label = label;
+        job.colors.shape = aShapeTool->GetShape(label).Located(TopLoc_Location());
+        if(job.colors.shape.IsNull())
+            continue;
+        getColor(job.colors.shape,job.info);
+        jobs.push_back(std::move(job));
+    }
+
+    auto func = [](Job &job) {
+        try {
+            mapSubShapeColors(job.colors.shape, job.info, job.subs, job.colors);
+        } catch (Standard_Failure &) {
+            // Leave it to createObject() to retry and report the error
+            job.colors.shape.Nullify();
+        }
+    };
+#if OCC_VERSION_HEX >= 0x070000
+    // Handle reference counting is only thread safe since OCCT 7
+    QtConcurrent::blockingMap(jobs, func);
+#else
+    std::for_each(jobs.begin(), jobs.end(), func);
+#endif
+
+    for(auto &job : jobs) {
+        if(!job.colors.shape.IsNull())
+            myColors.emplace(job.label, std::move(job.colors));
+    }
+}
+
 App::Document *ImportOCAF2::getDocument(App::Document *doc, TDF_Label label) {
     if(filePath.empty() || mode==SingleDoc || merge)
         return doc;
@@ -535,12 +620,23 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     if(FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
         dumpLabels(pDoc->Main(),aShapeTool,aColorTool);
 
+    // Defer object change notification (e.g. to the tree view and view
+    // providers) until all objects are created.
+    App::ChangeBatch batch;
+
     TDF_LabelSequence labels;
     aShapeTool->GetShapes(labels);
     Base::SequencerLauncher seq("Importing...",labels.Length());
     FC_MSG("free shape count " << labels.Length());
     sequencer = showProgress?&seq:0;
 
+    // Only the mapping of sub shape colors to face and edge indices runs in
+    // parallel. Reading the file, walking the XCAF labels and creating the
+    // objects stay in this thread. Without parallelColors, createObject()
+    // maps the colors of each shape as it goes.
+    if(parallelColors)
+        prepareShapeColors(labels);
+
     labels.Clear();
     myShapes.clear();
     myNames.clear();
@@ -597,6 +693,7 @@ App::DocumentObject* ImportOCAF2::loadShapes()
         ret->recomputeFeature(true);
     }
     sequencer = 0;
+    myColors.clear();
     return ret;
 }
 
@@ -1093,6 +1190,7 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const c
     if(objs.empty())
         return;
     myObjects.clear();
+    myShapes.clear();
     myNames.clear();
     mySetups.clear();
     if(objs.size()==1)
@@ -1181,9 +1279,11 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
             // a new shape every time Part::Feature::getTopoShape() is called.
             auto baseShape = aShapeTool->GetShape(it->second);
             shape.setShape(baseShape.Located(shape.getShape().Location()));
-            if(!parent.IsNull())
-                label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
-            else
+            if(!parent.IsNull()) {
+                // Refer to the label directly instead of letting OCCT search
+                // for it using the shape.
+                label = aShapeTool->AddComponent(parent,it->second,shape.getShape().Location());
+            }else
                 label = aShapeTool->AddShape(shape.getShape(),Standard_False,Standard_False);
             setupObject(label,name?parentObj:obj,shape,prefix,name);
             return label;
@@ -1200,17 +1300,23 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     if(subs.empty()) {
 
         if(!parent.IsNull()) {
-            // Search for non-located shape to see if we've stored the original shape before
-            if(!aShapeTool->FindShape(shape.getShape(),label)) {
+            // Search for non-located shape to see if we've stored the original
+            // shape before. Objects sharing the same TopoDS_TShape are
+            // exported as instances of the same shape. We keep our own map
+            // because ShapeTool::FindShape() performs a linear search.
+            TopoDS_Shape key = shape.getShape().Located(TopLoc_Location());
+            key.Orientation(TopAbs_FORWARD);
+            auto res = myShapes.emplace(key,TDF_Label());
+            if(res.second && !aShapeTool->FindShape(shape.getShape(),res.first->second)) {
                 auto baseShape = linkedShape;
                 auto linked = links.empty()?obj:links.back();
                 baseShape.setShape(baseShape.getShape().Located(TopLoc_Location()));
-                label = aShapeTool->NewShape();
-                aShapeTool->SetShape(label,baseShape.getShape());
-                setupObject(label,linked,baseShape,prefix);
+                res.first->second = aShapeTool->NewShape();
+                aShapeTool->SetShape(res.first->second,baseShape.getShape());
+                setupObject(res.first->second,linked,baseShape,prefix);
             }
 
-            label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
+            label = aShapeTool->AddComponent(parent,res.first->second,shape.getShape().Location());
             setupObject(label,name?parentObj:obj,shape,prefix,name);
 
         }else{
@@ -28,6 +28,7 @@
 #include <XCAFDoc_ShapeTool.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TDF_LabelMapHasher.hxx>
+#include <TDF_LabelSequence.hxx>
 #include <climits>
 #include <string>
 #include <set>
@@ -80,6 +81,7 @@ public:
     void setReduceObjects(bool enable) {reduceObjects=enable;}
     void setShowProgress(bool enable) {showProgress=enable;}
     void setExpandCompound(bool enable) {expandCompound=enable;}
+    void setParallelColors(bool enable) {parallelColors=enable;}
 
     enum ImportMode {
         SingleDoc = 0,
@@ -104,6 +106,22 @@ private:
         int free = true;
     };
 
+    struct SubShapeColor {
+        TopoDS_Shape shape;
+        App::Color faceColor;
+        App::Color edgeColor;
+        bool hasFaceColor = false;
+        bool hasEdgeColor = false;
+    };
+
+    struct ShapeColors {
+        TopoDS_Shape shape;
+        std::vector<App::Color> faceColors;
+        std::vector<App::Color> edgeColors;
+        bool hasFaceColors = false;
+        bool hasEdgeColors = false;
+    };
+
     App::DocumentObject *loadShape(App::Document *doc, TDF_Label label, 
             const TopoDS_Shape &shape, bool baseOnly=false, bool newDoc=true);
     App::Document *getDocument(App::Document *doc, TDF_Label label);
@@ -119,6 +137,10 @@ private:
     void setObjectName(Info &info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
     App::DocumentObject *expandShape(App::Document *doc, TDF_Label label, const TopoDS_Shape &shape);
+    bool getSubShapeColors(TDF_Label label, std::vector<SubShapeColor> &subs);
+    static void mapSubShapeColors(const TopoDS_Shape &shape, const Info &info,
+            const std::vector<SubShapeColor> &subs, ShapeColors &colors);
+    void prepareShapeColors(const TDF_LabelSequence &labels);
 
     virtual void applyEdgeColors(Part::Feature*, const std::vector<App::Color>&) {}
     virtual void applyFaceColors(Part::Feature*, const std::vector<App::Color>&) {}
@@ -153,6 +175,7 @@ private:
     bool reduceObjects;
     bool showProgress;
     bool expandCompound;
+    bool parallelColors;
 
     int mode;
     std::string filePath;
@@ -160,6 +183,8 @@ private:
     std::unordered_map<TopoDS_Shape, Info, ShapeHasher> myShapes;
     std::unordered_map<TDF_Label, std::string, LabelHasher> myNames;
     std::unordered_map<App::DocumentObject*, App::PropertyPlacement*> myCollapsedObjects;
+    // Sub shape colors mapped in advance by prepareShapeColors()
+    std::unordered_map<TDF_Label, ShapeColors, LabelHasher> myColors;
 
     App::Color defaultFaceColor;
     App::Color defaultEdgeColor;
@@ -193,6 +218,8 @@ private:
     Handle(XCAFDoc_ColorTool) aColorTool;
 
     std::unordered_map<App::DocumentObject *, TDF_Label> myObjects;
+    // Map from non-located shape to its label for instance sharing
+    std::unordered_map<TopoDS_Shape, TDF_Label, ShapeHasher> myShapes;
 
     std::unordered_map<TDF_Label, std::vector<std::string>, LabelHasher> myNames;
 
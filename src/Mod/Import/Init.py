@@ -39,3 +39,5 @@ FreeCAD.addExportType("STEPZ zip File Type (*.stpZ *.stpz)","stepZ")
 paramGetV = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Import/hSTEP")
 if  paramGetV.GetBool("ReadShapeCompoundMode", False) != paramGetV.GetBool("ReadShapeCompoundMode", True):
     paramGetV.SetBool("ReadShapeCompoundMode", True)
+
+FreeCAD.__unit_test__ += [ "TestImportApp" ]
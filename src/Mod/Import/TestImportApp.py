@@ -0,0 +1,56 @@
+# Unit tests for the Import module
+# LGPL
+
+import FreeCAD, unittest, Part, Import, os, tempfile
+
+
+def roundColor(color):
+    return tuple(round(c, 3) for c in color[:3])
+
+
+class ShapeColorCases(unittest.TestCase):
+    def setUp(self):
+        self.fileName = os.path.join(tempfile.gettempdir(), "ImportColors.step")
+        doc = FreeCAD.newDocument("ImportColorsSource")
+        box = doc.addObject("Part::Feature", "Box")
+        box.Shape = Part.makeBox(10, 10, 10)
+        cylinder = doc.addObject("Part::Feature", "Cylinder")
+        cylinder.Shape = Part.makeCylinder(5, 10, FreeCAD.Vector(20, 0, 0))
+        pair = doc.addObject("Part::Feature", "Pair")
+        pair.Shape = Part.makeCompound([Part.makeBox(5, 5, 5, FreeCAD.Vector(0, 20, 0)),
+                                        Part.makeBox(5, 5, 5, FreeCAD.Vector(10, 20, 0))])
+        sphere = doc.addObject("Part::Feature", "Sphere")
+        sphere.Shape = Part.makeSphere(5, FreeCAD.Vector(40, 0, 0))
+        doc.recompute()
+
+        self.boxColors = dict(("Face%d" % (i + 1), (0.1 * i, 0.5, 1.0 - 0.1 * i))
+                              for i in range(6))
+        colors = {"Box": self.boxColors,
+                  "Cylinder": {"Face1": (1.0, 0.0, 0.0), "Edge1": (0.0, 1.0, 0.0)},
+                  "Pair": {"Face": (0.0, 0.0, 1.0), "Face1": (1.0, 1.0, 0.0),
+                           "Face9": (0.0, 1.0, 1.0)}}
+        Import.export([box, cylinder, pair, sphere], self.fileName, colors=colors)
+        FreeCAD.closeDocument(doc.Name)
+
+    def tearDown(self):
+        os.remove(self.fileName)
+
+    def importColors(self, parallel):
+        doc = FreeCAD.newDocument("ImportColors")
+        result = Import.insert(self.fileName, doc.Name, merge=False,
+                               parallelColors=parallel)
+        colors = dict((feature.Label, faceColors) for feature, faceColors in result or [])
+        FreeCAD.closeDocument(doc.Name)
+        return colors
+
+    def testParallelMatchesSerial(self):
+        serial = self.importColors(False)
+        parallel = self.importColors(True)
+        self.assertTrue(len(serial) >= 3)
+        self.assertEqual(serial, parallel)
+
+        # the colors made it through the file, not just the defaults
+        box = [colors for label, colors in serial.items() if label.startswith("Box")]
+        self.assertEqual(len(box), 1)
+        self.assertEqual(set(roundColor(c) for c in box[0]),
+                         set(roundColor(c) for c in self.boxColors.values()))
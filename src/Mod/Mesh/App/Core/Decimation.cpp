@@ -23,11 +23,16 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <map>
 #endif
 
+#include <QtConcurrentMap>
+#include <QThread>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
+#include "Builder.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 #include <Base/Tools.h>
@@ -144,3 +149,190 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+// --------------------------------------------------------------
+
+namespace MeshCore {
+struct SimplifyBlock
+{
+    SimplifyBlock() : targetSize(0) {}
+    std::vector<unsigned long> facets;
+    // three points per facet of the simplified block
+    std::vector<Base::Vector3f> result;
+    int targetSize;
+};
+}
+
+MeshBlockSimplify::MeshBlockSimplify(MeshKernel& mesh)
+  : myKernel(mesh)
+  , myBlocks(4)
+  , myFeatureAngle(Base::toRadians<float>(60.0f))
+  , myKeepBoundary(true)
+{
+}
+
+MeshBlockSimplify::~MeshBlockSimplify()
+{
+}
+
+void MeshBlockSimplify::SetBlocks(int num)
+{
+    myBlocks = std::max<int>(1, num);
+}
+
+void MeshBlockSimplify::SetFeatureAngle(float angle)
+{
+    myFeatureAngle = angle;
+}
+
+void MeshBlockSimplify::SetKeepBoundary(bool on)
+{
+    myKeepBoundary = on;
+}
+
+void MeshBlockSimplify::simplify(float tolerance, float reduction)
+{
+    simplify(tolerance, reduction, -1);
+}
+
+void MeshBlockSimplify::simplify(int targetSize)
+{
+    simplify(FLT_MAX, 0.0f, targetSize);
+}
+
+void MeshBlockSimplify::simplify(float tolerance, float reduction, int targetSize)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    unsigned long ctFacets = facets.size();
+    if (ctFacets == 0)
+        return;
+
+    // assign each facet to the block containing its center of gravity
+    Base::BoundBox3f bbox = myKernel.GetBoundBox();
+    float lenX = std::max<float>(bbox.LengthX(), FLT_EPSILON);
+    float lenY = std::max<float>(bbox.LengthY(), FLT_EPSILON);
+    float lenZ = std::max<float>(bbox.LengthZ(), FLT_EPSILON);
+    int num = myBlocks;
+
+    std::vector<SimplifyBlock> blocks(num * num * num);
+    std::vector<int> blockOfFacet(ctFacets);
+    for (unsigned long i = 0; i < ctFacets; i++) {
+        Base::Vector3f center = myKernel.GetFacet(facets[i]).GetGravityPoint();
+        int x = std::min<int>(num - 1, static_cast<int>(num * (center.x - bbox.MinX) / lenX));
+        int y = std::min<int>(num - 1, static_cast<int>(num * (center.y - bbox.MinY) / lenY));
+        int z = std::min<int>(num - 1, static_cast<int>(num * (center.z - bbox.MinZ) / lenZ));
+        int index = (z * num + y) * num + x;
+        blockOfFacet[i] = index;
+        blocks[index].facets.push_back(i);
+    }
+
+    // lock the points that are shared by several blocks or that lie on
+    // boundary or feature edges
+    std::vector<int> ownerOfPoint(points.size(), -1);
+    std::vector<bool> locked(points.size(), false);
+    for (unsigned long i = 0; i < ctFacets; i++) {
+        const MeshFacet& face = facets[i];
+        int block = blockOfFacet[i];
+        for (int j = 0; j < 3; j++) {
+            unsigned long ulPt = face._aulPoints[j];
+            if (ownerOfPoint[ulPt] < 0)
+                ownerOfPoint[ulPt] = block;
+            else if (ownerOfPoint[ulPt] != block)
+                locked[ulPt] = true;
+        }
+
+        for (int j = 0; j < 3; j++) {
+            unsigned long ulNb = face._aulNeighbours[j];
+            bool lockEdge = false;
+            if (ulNb == ULONG_MAX) {
+                lockEdge = myKeepBoundary;
+            }
+            else if (ulNb > i && myFeatureAngle > 0.0f) {
+                Base::Vector3f n1 = myKernel.GetFacet(face).GetNormal();
+                Base::Vector3f n2 = myKernel.GetFacet(facets[ulNb]).GetNormal();
+                lockEdge = n1.GetAngle(n2) > myFeatureAngle;
+            }
+
+            if (lockEdge) {
+                locked[face._aulPoints[j]] = true;
+                locked[face._aulPoints[(j+1)%3]] = true;
+            }
+        }
+    }
+
+    std::vector<int>().swap(ownerOfPoint);
+    std::vector<int>().swap(blockOfFacet);
+
+    for (std::vector<SimplifyBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        std::size_t size = it->facets.size();
+        if (targetSize < 0) {
+            it->targetSize = static_cast<int>(static_cast<float>(size) * (1.0f-reduction));
+        }
+        else {
+            double ratio = static_cast<double>(targetSize) / static_cast<double>(ctFacets);
+            it->targetSize = static_cast<int>(static_cast<double>(size) * ratio);
+        }
+    }
+
+    // simplify a block, only its facets are copied into the working structures
+    auto simplifyBlock = [&points, &facets, &locked, tolerance](SimplifyBlock& block) {
+        if (block.facets.empty())
+            return;
+
+        Simplify alg;
+        std::map<unsigned long, int> localIndex;
+        alg.triangles.reserve(block.facets.size());
+        for (std::vector<unsigned long>::iterator it = block.facets.begin(); it != block.facets.end(); ++it) {
+            const MeshFacet& face = facets[*it];
+            Simplify::Triangle t;
+            for (int j = 0; j < 3; j++) {
+                unsigned long ulPt = face._aulPoints[j];
+                std::map<unsigned long, int>::iterator jt = localIndex.find(ulPt);
+                if (jt == localIndex.end()) {
+                    Simplify::Vertex v;
+                    v.p = points[ulPt];
+                    v.locked = locked[ulPt] ? 1 : 0;
+                    jt = localIndex.insert(std::make_pair(ulPt, static_cast<int>(alg.vertices.size()))).first;
+                    alg.vertices.push_back(v);
+                }
+                t.v[j] = jt->second;
+            }
+            alg.triangles.push_back(t);
+        }
+
+        std::vector<unsigned long>().swap(block.facets);
+        alg.simplify_mesh(block.targetSize, tolerance);
+
+        block.result.reserve(3 * alg.triangles.size());
+        for (std::size_t i = 0; i < alg.triangles.size(); i++) {
+            const Simplify::Triangle& t = alg.triangles[i];
+            if (!t.deleted) {
+                for (int j = 0; j < 3; j++)
+                    block.result.push_back(alg.vertices[t.v[j]].p);
+            }
+        }
+    };
+
+    // the blocks are simplified in batches of one block per thread and the
+    // result of a batch is added to the builder before the next batch starts.
+    // The locked points haven't been moved and thus are merged again.
+    std::size_t numFacets = 0;
+    for (std::vector<SimplifyBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+        numFacets += static_cast<std::size_t>(it->targetSize);
+
+    MeshFastBuilder builder(myKernel);
+    builder.Initialize(static_cast<MeshFastBuilder::size_type>(numFacets));
+    std::size_t batchSize = static_cast<std::size_t>(std::max<int>(1, QThread::idealThreadCount()));
+    for (std::size_t first = 0; first < blocks.size(); first += batchSize) {
+        std::vector<SimplifyBlock>::iterator begin = blocks.begin() + first;
+        std::vector<SimplifyBlock>::iterator end = blocks.begin() + std::min(first + batchSize, blocks.size());
+        QtConcurrent::blockingMap(begin, end, simplifyBlock);
+        for (std::vector<SimplifyBlock>::iterator it = begin; it != end; ++it) {
+            for (std::size_t i = 0; i + 2 < it->result.size(); i += 3)
+                builder.AddFacet(&it->result[i]);
+            std::vector<Base::Vector3f>().swap(it->result);
+        }
+    }
+    builder.Finish();
+}
@@ -41,6 +41,42 @@ private:
     MeshKernel& myKernel;
 };
 
+/**
+ * The MeshBlockSimplify class decimates a mesh block-wise. The bounding box of the
+ * mesh is divided into a regular grid of blocks and each block is simplified
+ * independently with the quadric error metric in a separate thread.
+ * Vertices shared by facets of different blocks are locked so that the blocks can
+ * be stitched together afterwards. Additionally, vertices of boundary and feature
+ * edges are locked to preserve them.
+ * The blocks are simplified in batches of one block per thread, and the result of a
+ * batch is merged into the output before the next batch starts. So the working
+ * structures of the simplification only exist for the blocks of one batch. The facet
+ * indices of all blocks and the output mesh are still held in memory as a whole.
+ */
+class MeshExport MeshBlockSimplify
+{
+public:
+    MeshBlockSimplify(MeshKernel&);
+    ~MeshBlockSimplify();
+    /// Sets the number of blocks along each axis of the bounding box.
+    void SetBlocks(int num);
+    /// Facets whose normals differ by more than \a angle (in radians) define a feature edge.
+    void SetFeatureAngle(float angle);
+    /// If true boundary edges are preserved.
+    void SetKeepBoundary(bool on);
+    void simplify(float tolerance, float reduction);
+    void simplify(int targetSize);
+
+private:
+    void simplify(float tolerance, float reduction, int targetSize);
+
+private:
+    MeshKernel& myKernel;
+    int myBlocks;
+    float myFeatureAngle;
+    bool myKeepBoundary;
+};
+
 } // namespace MeshCore
 
 
@@ -0,0 +1,186 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <climits>
+#endif
+
+#include "KernelSnapshot.h"
+#include "MeshKernel.h"
+#include <Base/Exception.h>
+
+using namespace MeshCore;
+
+// The largest index is reserved to mark a missing neighbour
+static const MeshKernelSnapshot::index_type NoIndex = UINT32_MAX;
+
+MeshKernelSnapshot::MeshKernelSnapshot()
+{
+}
+
+MeshKernelSnapshot::MeshKernelSnapshot(const MeshKernel& kernel)
+{
+    SetKernel(kernel);
+}
+
+MeshKernelSnapshot::~MeshKernelSnapshot()
+{
+}
+
+MeshKernelSnapshot::index_type MeshKernelSnapshot::toCompact(unsigned long index)
+{
+    return index == ULONG_MAX ? NoIndex : static_cast<index_type>(index);
+}
+
+unsigned long MeshKernelSnapshot::fromCompact(index_type index)
+{
+    return index == NoIndex ? ULONG_MAX : static_cast<unsigned long>(index);
+}
+
+bool MeshKernelSnapshot::IsCompatible(const MeshKernel& kernel)
+{
+    return kernel.CountPoints() < NoIndex && kernel.CountFacets() < NoIndex;
+}
+
+void MeshKernelSnapshot::Clear()
+{
+    std::vector<Base::Vector3f>().swap(points);
+    std::vector<index_type>().swap(facetPoints);
+    std::vector<index_type>().swap(facetNeighbours);
+    std::vector<unsigned char>().swap(pointFlags);
+    std::vector<unsigned char>().swap(facetFlags);
+    std::vector<unsigned long>().swap(pointProps);
+    std::vector<unsigned long>().swap(facetProps);
+    boundBox = Base::BoundBox3f();
+}
+
+void MeshKernelSnapshot::SetKernel(const MeshKernel& kernel)
+{
+    if (!IsCompatible(kernel))
+        throw Base::ValueError("Mesh has too many elements for 32-bit indices");
+
+    Clear();
+
+    const MeshPointArray& rPoints = kernel.GetPoints();
+    const MeshFacetArray& rFacets = kernel.GetFacets();
+
+    // the cold data is only stored if it's used at all
+    bool hasPointFlags = false, hasPointProps = false;
+    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
+        hasPointFlags = hasPointFlags || it->_ucFlag != 0;
+        hasPointProps = hasPointProps || it->_ulProp != 0;
+    }
+
+    bool hasFacetFlags = false, hasFacetProps = false;
+    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
+        hasFacetFlags = hasFacetFlags || it->_ucFlag != 0;
+        hasFacetProps = hasFacetProps || it->_ulProp != 0;
+    }
+
+    points.reserve(rPoints.size());
+    if (hasPointFlags)
+        pointFlags.reserve(rPoints.size());
+    if (hasPointProps)
+        pointProps.reserve(rPoints.size());
+    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
+        points.push_back(*it);
+        if (hasPointFlags)
+            pointFlags.push_back(it->_ucFlag);
+        if (hasPointProps)
+            pointProps.push_back(it->_ulProp);
+    }
+
+    facetPoints.reserve(3 * rFacets.size());
+    facetNeighbours.reserve(3 * rFacets.size());
+    if (hasFacetFlags)
+        facetFlags.reserve(rFacets.size());
+    if (hasFacetProps)
+        facetProps.reserve(rFacets.size());
+    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
+        for (int i=0; i<3; i++) {
+            facetPoints.push_back(toCompact(it->_aulPoints[i]));
+            facetNeighbours.push_back(toCompact(it->_aulNeighbours[i]));
+        }
+        if (hasFacetFlags)
+            facetFlags.push_back(it->_ucFlag);
+        if (hasFacetProps)
+            facetProps.push_back(it->_ulProp);
+    }
+
+    boundBox = kernel.GetBoundBox();
+}
+
+void MeshKernelSnapshot::GetKernel(MeshKernel& kernel) const
+{
+    MeshPointArray rPoints;
+    rPoints.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        MeshPoint pnt(points[i]);
+        if (!pointFlags.empty())
+            pnt._ucFlag = pointFlags[i];
+        if (!pointProps.empty())
+            pnt._ulProp = pointProps[i];
+        rPoints.push_back(pnt);
+    }
+
+    unsigned long ctFacets = CountFacets();
+    MeshFacetArray rFacets;
+    rFacets.reserve(ctFacets);
+    for (unsigned long i = 0; i < ctFacets; i++)
+        rFacets.push_back(GetTopoFacet(i));
+
+    // the neighbourhood is stored as well
+    kernel.Adopt(rPoints, rFacets, false);
+}
+
+MeshGeomFacet MeshKernelSnapshot::GetFacet(unsigned long index) const
+{
+    const index_type* pnts = &facetPoints[3 * index];
+    MeshGeomFacet facet(points[pnts[0]], points[pnts[1]], points[pnts[2]]);
+    facet._ucFlag = GetFacetFlag(index);
+    facet._ulProp = GetFacetProperty(index);
+    return facet;
+}
+
+MeshFacet MeshKernelSnapshot::GetTopoFacet(unsigned long index) const
+{
+    const index_type* pnts = &facetPoints[3 * index];
+    const index_type* nbrs = &facetNeighbours[3 * index];
+    MeshFacet facet(fromCompact(pnts[0]), fromCompact(pnts[1]), fromCompact(pnts[2]),
+                    fromCompact(nbrs[0]), fromCompact(nbrs[1]), fromCompact(nbrs[2]));
+    facet._ucFlag = GetFacetFlag(index);
+    facet._ulProp = GetFacetProperty(index);
+    return facet;
+}
+
+std::size_t MeshKernelSnapshot::GetMemSize() const
+{
+    return points.capacity() * sizeof(Base::Vector3f) +
+           facetPoints.capacity() * sizeof(index_type) +
+           facetNeighbours.capacity() * sizeof(index_type) +
+           pointFlags.capacity() * sizeof(unsigned char) +
+           facetFlags.capacity() * sizeof(unsigned char) +
+           pointProps.capacity() * sizeof(unsigned long) +
+           facetProps.capacity() * sizeof(unsigned long);
+}
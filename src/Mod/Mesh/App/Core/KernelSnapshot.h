@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_KERNELSNAPSHOT_H
+#define MESH_KERNELSNAPSHOT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Elements.h"
+
+namespace MeshCore
+{
+class MeshKernel;
+
+/**
+ * The MeshKernelSnapshot class is a read-only, memory saving copy of a mesh.
+ * Unlike MeshKernel that stores arrays of MeshPoint and MeshFacet with indices,
+ * flags and properties of type unsigned long it keeps the data in separate
+ * columns and uses 32-bit indices. The rarely used flags and properties
+ * (cold data) are kept in side arrays that are only allocated when needed.
+ * On 64-bit platforms a facet needs 25 instead of 64 bytes and a point 13
+ * instead of 24 bytes.
+ *
+ * It is not a storage mode of a live MeshKernel: the algorithms work on
+ * MeshKernel only. A snapshot keeps the old mesh of a full undo record (see
+ * Mesh::PropertyMeshKernel::CopyOnChange()) and is converted back with
+ * GetKernel(). For simple read access use GetFacet() or GetTopoFacet().
+ */
+class MeshExport MeshKernelSnapshot
+{
+public:
+    typedef std::uint32_t index_type;
+
+    MeshKernelSnapshot();
+    /// Creates the snapshot of the given mesh. If the mesh has too many
+    /// elements for 32-bit indices a Base::ValueError is thrown.
+    explicit MeshKernelSnapshot(const MeshKernel&);
+    ~MeshKernelSnapshot();
+
+    /** @name Conversion */
+    //@{
+    void SetKernel(const MeshKernel&);
+    void GetKernel(MeshKernel&) const;
+    void Clear();
+    /// Checks whether the given mesh can be stored with 32-bit indices
+    static bool IsCompatible(const MeshKernel&);
+    //@}
+
+    /** @name Querying */
+    //@{
+    unsigned long CountPoints() const
+    { return static_cast<unsigned long>(points.size()); }
+    unsigned long CountFacets() const
+    { return static_cast<unsigned long>(facetPoints.size() / 3); }
+    /// Returns the number of required memory in bytes
+    std::size_t GetMemSize() const;
+    const Base::BoundBox3f& GetBoundBox() const
+    { return boundBox; }
+    Base::Vector3f GetPoint(unsigned long index) const
+    { return points[index]; }
+    MeshGeomFacet GetFacet(unsigned long index) const;
+    /// Returns the facet with indices, flag and property
+    MeshFacet GetTopoFacet(unsigned long index) const;
+    unsigned char GetFacetFlag(unsigned long index) const
+    { return facetFlags.empty() ? 0 : facetFlags[index]; }
+    unsigned long GetFacetProperty(unsigned long index) const
+    { return facetProps.empty() ? 0 : facetProps[index]; }
+    unsigned char GetPointFlag(unsigned long index) const
+    { return pointFlags.empty() ? 0 : pointFlags[index]; }
+    unsigned long GetPointProperty(unsigned long index) const
+    { return pointProps.empty() ? 0 : pointProps[index]; }
+    //@}
+
+private:
+    static index_type toCompact(unsigned long);
+    static unsigned long fromCompact(index_type);
+
+private:
+    // hot data
+    std::vector<Base::Vector3f> points;
+    std::vector<index_type> facetPoints;
+    std::vector<index_type> facetNeighbours;
+    // cold data, empty if unused
+    std::vector<unsigned char> pointFlags;
+    std::vector<unsigned char> facetFlags;
+    std::vector<unsigned long> pointProps;
+    std::vector<unsigned long> facetProps;
+    Base::BoundBox3f boundBox;
+};
+
+} // namespace MeshCore
+
+#endif // MESH_KERNELSNAPSHOT_H
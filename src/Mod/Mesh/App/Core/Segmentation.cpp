@@ -25,6 +25,9 @@
 #include <algorithm>
 #endif
 
+#include <atomic>
+#include <QtConcurrentMap>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
@@ -104,6 +107,12 @@ void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
     fitter->AddPoint(triangle.GetGravityPoint());
 }
 
+void MeshDistancePlanarSegment::PrepareTest()
+{
+    if (!fitter->Done())
+        fitter->Fit();
+}
+
 // --------------------------------------------------------
 
 PlaneSurfaceFit::PlaneSurfaceFit()
@@ -443,6 +452,12 @@ void MeshDistanceGenericSurfaceFitSegment::AddFacet(const MeshFacet& face)
     fitter->AddTriangle(triangle);
 }
 
+void MeshDistanceGenericSurfaceFitSegment::PrepareTest()
+{
+    if (!fitter->Done())
+        fitter->Fit();
+}
+
 std::vector<float> MeshDistanceGenericSurfaceFitSegment::Parameters() const
 {
     return fitter->Parameters();
@@ -589,3 +604,194 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+namespace MeshCore {
+namespace {
+typedef std::vector<std::atomic<unsigned long> > ConcurrentParents;
+
+// Lock-free union-find. The root of a set is always its smallest element.
+unsigned long findRoot(ConcurrentParents& parent, unsigned long x)
+{
+    for (;;) {
+        unsigned long p = parent[x].load();
+        if (p == x)
+            return x;
+        unsigned long gp = parent[p].load();
+        if (p != gp) {
+            // path halving
+            unsigned long expected = p;
+            parent[x].compare_exchange_weak(expected, gp);
+        }
+        x = gp;
+    }
+}
+
+void uniteSets(ConcurrentParents& parent, unsigned long a, unsigned long b)
+{
+    for (;;) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+        // only succeeds if 'a' is still a root
+        unsigned long expected = a;
+        if (parent[a].compare_exchange_strong(expected, b))
+            return;
+    }
+}
+
+struct FacetCandidate {
+    unsigned long index;
+    bool accept;
+};
+}
+}
+
+void MeshSegmentAlgorithm::FindSegmentsParallel(std::vector<MeshSurfaceSegmentPtr>& segm)
+{
+    // facets that belong to a segment of a previously handled type are skipped
+    std::vector<bool> visited(myKernel.CountFacets(), false);
+    for (std::vector<MeshSurfaceSegmentPtr>::iterator it = segm.begin(); it != segm.end(); ++it) {
+        if ((*it)->IsIndependent())
+            FindIndependentSegments(**it, visited);
+        else
+            FindFittedSegments(**it, visited);
+    }
+}
+
+void MeshSegmentAlgorithm::FindIndependentSegments(MeshSurfaceSegment& segm, std::vector<bool>& visited)
+{
+    const MeshFacetArray& rFAry = myKernel.GetFacets();
+    unsigned long numFacets = rFAry.size();
+
+    std::vector<unsigned long> indices;
+    indices.reserve(numFacets);
+    for (unsigned long i = 0; i < numFacets; i++) {
+        if (!visited[i])
+            indices.push_back(i);
+    }
+
+    // test all facets in parallel
+    std::vector<char> accepted(numFacets, 0);
+    QtConcurrent::blockingMap(indices, [&segm, &rFAry, &accepted](unsigned long& index) {
+        accepted[index] = segm.TestFacet(rFAry[index]) ? 1 : 0;
+    });
+
+    // connect accepted neighbours in parallel
+    ConcurrentParents parent(numFacets);
+    for (unsigned long i = 0; i < numFacets; i++)
+        parent[i].store(i);
+
+    QtConcurrent::blockingMap(indices, [&rFAry, &accepted, &parent](unsigned long& index) {
+        if (!accepted[index])
+            return;
+        const MeshFacet& face = rFAry[index];
+        for (int i = 0; i < 3; i++) {
+            unsigned long nb = face._aulNeighbours[i];
+            if (nb != ULONG_MAX && nb > index && accepted[nb])
+                uniteSets(parent, index, nb);
+        }
+    });
+
+    // collect the components ordered by their smallest facet index
+    std::vector<MeshSegment> components;
+    std::vector<unsigned long> componentOfRoot(numFacets, ULONG_MAX);
+    for (std::vector<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
+        if (!accepted[*it])
+            continue;
+        unsigned long root = findRoot(parent, *it);
+        if (componentOfRoot[root] == ULONG_MAX) {
+            componentOfRoot[root] = components.size();
+            components.push_back(MeshSegment());
+        }
+        components[componentOfRoot[root]].push_back(*it);
+    }
+
+    for (std::vector<MeshSegment>::iterator it = components.begin(); it != components.end(); ++it) {
+        if (it->size() > 1) {
+            for (MeshSegment::iterator jt = it->begin(); jt != it->end(); ++jt)
+                visited[*jt] = true;
+            segm.AddSegment(*it);
+        }
+    }
+}
+
+void MeshSegmentAlgorithm::FindFittedSegments(MeshSurfaceSegment& segm, std::vector<bool>& visited)
+{
+    const MeshFacetArray& rFAry = myKernel.GetFacets();
+    unsigned long numFacets = rFAry.size();
+
+    // fronts smaller than this are tested in the calling thread
+    const std::size_t minParallelFront = 64;
+    std::vector<unsigned long> frontOfFacet(numFacets, ULONG_MAX);
+    unsigned long frontId = 0;
+    std::vector<unsigned long> resetVisited;
+
+    for (unsigned long startFacet = 0; startFacet < numFacets; startFacet++) {
+        if (visited[startFacet])
+            continue;
+
+        visited[startFacet] = true;
+        segm.Initialize(startFacet);
+        if (!segm.TestInitialFacet(startFacet)) {
+            resetVisited.push_back(startFacet);
+            continue;
+        }
+
+        std::vector<unsigned long> indices;
+        indices.push_back(startFacet);
+        std::vector<unsigned long> front = indices;
+        std::vector<FacetCandidate> candidates;
+
+        while (!front.empty()) {
+            frontId++;
+            candidates.clear();
+            for (std::vector<unsigned long>::iterator it = front.begin(); it != front.end(); ++it) {
+                const MeshFacet& face = rFAry[*it];
+                for (int i = 0; i < 3; i++) {
+                    unsigned long nb = face._aulNeighbours[i];
+                    if (nb != ULONG_MAX && !visited[nb] && frontOfFacet[nb] != frontId) {
+                        frontOfFacet[nb] = frontId;
+                        FacetCandidate candidate;
+                        candidate.index = nb;
+                        candidate.accept = false;
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+
+            // re-fit once for the whole front
+            segm.PrepareTest();
+            if (candidates.size() < minParallelFront) {
+                for (std::vector<FacetCandidate>::iterator it = candidates.begin(); it != candidates.end(); ++it)
+                    it->accept = segm.TestFacet(rFAry[it->index]);
+            }
+            else {
+                QtConcurrent::blockingMap(candidates, [&segm, &rFAry](FacetCandidate& candidate) {
+                    candidate.accept = segm.TestFacet(rFAry[candidate.index]);
+                });
+            }
+
+            front.clear();
+            for (std::vector<FacetCandidate>::iterator it = candidates.begin(); it != candidates.end(); ++it) {
+                if (it->accept) {
+                    visited[it->index] = true;
+                    indices.push_back(it->index);
+                    front.push_back(it->index);
+                    segm.AddFacet(rFAry[it->index]);
+                }
+            }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1)
+            resetVisited.push_back(startFacet);
+        else
+            segm.AddSegment(indices);
+    }
+
+    for (std::vector<unsigned long>::iterator it = resetVisited.begin(); it != resetVisited.end(); ++it)
+        visited[*it] = false;
+}
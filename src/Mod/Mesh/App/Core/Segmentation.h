@@ -48,6 +48,14 @@ public:
     virtual void Initialize(unsigned long);
     virtual bool TestInitialFacet(unsigned long) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /** Returns true if the result of TestFacet() only depends on the given facet
+     * and not on the facets that have been added to the segment before.
+     */
+    virtual bool IsIndependent() const { return false; }
+    /** Must be called before TestFacet() is called concurrently for a batch of
+     * facets. Afterwards TestFacet() doesn't modify the segment any more.
+     */
+    virtual void PrepareTest() {}
     void AddSegment(const std::vector<unsigned long>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(unsigned long) const;
@@ -80,6 +88,7 @@ public:
     const char* GetType() const { return "Plane"; }
     void Initialize(unsigned long);
     void AddFacet(const MeshFacet& rclFacet);
+    void PrepareTest();
 
 protected:
     Base::Vector3f basepoint;
@@ -177,6 +186,7 @@ public:
     void Initialize(unsigned long);
     bool TestInitialFacet(unsigned long) const;
     void AddFacet(const MeshFacet& rclFacet);
+    void PrepareTest();
     std::vector<float> Parameters() const;
 
 protected:
@@ -190,6 +200,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    bool IsIndependent() const { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -271,6 +282,21 @@ class MeshExport MeshSegmentAlgorithm
 public:
     MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /** Does basically the same as FindSegments() but uses several threads.
+     * For segments whose criterion is independent of the already added facets
+     * the facets are tested in parallel and the connected components are
+     * determined with a concurrent union-find over the facet adjacency.
+     * Segments with a fitted surface are grown front by front where all
+     * facets of a front are tested in parallel and the surface is re-fitted
+     * only once per front.
+     * Unlike FindSegments() a facet is only added to a segment if it fulfils
+     * the criterion.
+     */
+    void FindSegmentsParallel(std::vector<MeshSurfaceSegmentPtr>&);
+
+private:
+    void FindIndependentSegments(MeshSurfaceSegment&, std::vector<bool>& visited);
+    void FindFittedSegments(MeshSurfaceSegment&, std::vector<bool>& visited);
 
 private:
     const MeshKernel& myKernel;
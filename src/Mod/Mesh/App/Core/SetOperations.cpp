@@ -26,12 +26,17 @@
 
 #ifndef _PreComp_
 # include <ios>
+# include <cmath>
 #endif
 
 #include <fstream>
+#include <QtConcurrentMap>
+#include <QThread>
+
 #include "SetOperations.h"
 #include "Algorithm.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "Grid.h"
 #include "MeshIO.h"
@@ -44,6 +49,7 @@
 
 #include <Base/Sequencer.h>
 #include <Base/Builder3D.h>
+#include <Base/Converter.h>
 #include <Base/Tools2D.h>
 
 using namespace Base;
@@ -170,6 +176,141 @@ void SetOperations::Do ()
   MeshDefinitions::SetMinPointDistance(saveMinMeshDistance);
 }
 
+namespace MeshCore {
+namespace {
+// Error-free sum of two doubles: x + y == a + b exactly, see J.R. Shewchuk,
+// "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates"
+inline void TwoSum(double a, double b, double& x, double& y)
+{
+  x = a + b;
+  double bv = x - a;
+  double av = x - bv;
+  y = (a - av) + (b - bv);
+}
+
+// Adds b to the nonoverlapping expansion e, whose components are ordered
+// by increasing magnitude (Grow-Expansion with zero elimination)
+void GrowExpansion(std::vector<double>& e, double b)
+{
+  double q = b;
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < e.size(); i++)
+  {
+    double h;
+    TwoSum(q, e[i], q, h);
+    if (h != 0.0)
+      e[k++] = h;
+  }
+  e.resize(k);
+  e.push_back(q);
+}
+
+// Adds the product x*y*z of float values exactly to the expansion. x*y is
+// exact in double (48 bits), the rounding error of the second product is
+// recovered with fma.
+void AddProduct(std::vector<double>& e, double sign, float x, float y, float z)
+{
+  double xy = sign * double(x) * double(y);
+  double hi = xy * double(z);
+  double lo = std::fma(xy, double(z), -hi);
+  GrowExpansion(e, lo);
+  GrowExpansion(e, hi);
+}
+
+// Adds sign * det(r0, r1, r2) exactly to the expansion
+void AddDeterminant(std::vector<double>& e, double sign,
+                    const Base::Vector3f& r0, const Base::Vector3f& r1, const Base::Vector3f& r2)
+{
+  AddProduct(e,  sign, r0.x, r1.y, r2.z);
+  AddProduct(e, -sign, r0.x, r1.z, r2.y);
+  AddProduct(e, -sign, r0.y, r1.x, r2.z);
+  AddProduct(e,  sign, r0.y, r1.z, r2.x);
+  AddProduct(e,  sign, r0.z, r1.x, r2.y);
+  AddProduct(e, -sign, r0.z, r1.y, r2.x);
+}
+
+/**
+ * Exact sign of ((b-a) x (c-a)) * (p-a), i.e. the side of \a p with respect to
+ * the plane through \a a, \a b and \a c. The 4x4 orientation determinant is
+ * expanded into products of the float coordinates which are summed up without
+ * any rounding error. Only used for the rare cases the filter cannot decide.
+ */
+int ExactOrientation(const Base::Vector3f& a, const Base::Vector3f& b,
+                     const Base::Vector3f& c, const Base::Vector3f& p)
+{
+  std::vector<double> e;
+  e.reserve(48);
+  AddDeterminant(e,  1.0, b, c, p);
+  AddDeterminant(e, -1.0, a, c, p);
+  AddDeterminant(e,  1.0, a, b, p);
+  AddDeterminant(e, -1.0, a, b, c);
+
+  // the component with the largest magnitude is last and gives the sign
+  for (std::vector<double>::reverse_iterator it = e.rbegin(); it != e.rend(); ++it)
+  {
+    if (*it > 0.0)
+      return 1;
+    if (*it < 0.0)
+      return -1;
+  }
+  return 0;
+}
+
+/**
+ * Filtered orientation test of the facet \a g against the plane of \a f.
+ * The signed distances are computed in double precision. Those clearly away
+ * from zero decide at once, those within an error bound relative to the size
+ * of the involved facets are decided by ExactOrientation().
+ * Returns 1 if \a g lies completely on one side of the plane, 0 if it's
+ * coplanar and -1 if it crosses or touches the plane.
+ */
+int PlaneSideFilter(const MeshGeomFacet& f, const MeshGeomFacet& g)
+{
+  Base::Vector3d a = Base::convertTo<Base::Vector3d>(f._aclPoints[0]);
+  Base::Vector3d b = Base::convertTo<Base::Vector3d>(f._aclPoints[1]);
+  Base::Vector3d c = Base::convertTo<Base::Vector3d>(f._aclPoints[2]);
+  Base::Vector3d n = (b - a) % (c - a);
+
+  double scale = 0.0;
+  for (int i = 0; i < 3; i++)
+  {
+    scale = std::max<double>(scale, (Base::convertTo<Base::Vector3d>(g._aclPoints[i]) - a).Length());
+    scale = std::max<double>(scale, (Base::convertTo<Base::Vector3d>(f._aclPoints[i]) - a).Length());
+  }
+
+  // The rounding error of the double evaluation is in the order of
+  // DBL_EPSILON * scale^3. Using FLT_EPSILON keeps a wide safety margin
+  // while only values of nearly coplanar input need the exact test.
+  double eps = 8.0 * FLT_EPSILON * scale * scale * scale;
+
+  int pos = 0, neg = 0;
+  for (int i = 0; i < 3; i++)
+  {
+    double d = n * (Base::convertTo<Base::Vector3d>(g._aclPoints[i]) - a);
+    if (std::fabs(d) <= eps)
+      d = ExactOrientation(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], g._aclPoints[i]);
+    if (d > 0.0)
+      pos++;
+    else if (d < 0.0)
+      neg++;
+  }
+
+  if (pos == 3 || neg == 3)
+    return 1;
+  if (pos == 0 && neg == 0)
+    return 0;
+  return -1;
+}
+
+struct CellPairs
+{
+  unsigned long x, y, z;
+  std::vector<std::pair<unsigned long, unsigned long> > pairs;
+};
+}
+}
+
 void SetOperations::Cut (std::set<unsigned long>& facetsCuttingEdge0, std::set<unsigned long>& facetsCuttingEdge1)
 {
   MeshFacetGrid grid1(_cutMesh0, 20);
@@ -178,238 +319,192 @@ void SetOperations::Cut (std::set<unsigned long>& facetsCuttingEdge0, std::set<u
   unsigned long ctGx1, ctGy1, ctGz1;
   grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
 
-  unsigned long gx1;
-  for (gx1 = 0; gx1 < ctGx1; gx1++)  
+  std::vector<CellPairs> cells;
+  for (unsigned long gx1 = 0; gx1 < ctGx1; gx1++)
   {
-    unsigned long gy1;
-    for (gy1 = 0; gy1 < ctGy1; gy1++)
+    for (unsigned long gy1 = 0; gy1 < ctGy1; gy1++)
     {
-      unsigned long gz1;
-      for (gz1 = 0; gz1 < ctGz1; gz1++)
+      for (unsigned long gz1 = 0; gz1 < ctGz1; gz1++)
       {
         if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
         {
-          std::vector<unsigned long> vecFacets2;
-          grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-      
-          if (vecFacets2.size() > 0)
-          {
-            std::set<unsigned long> vecFacets1;
-            grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-            
-            std::set<unsigned long>::iterator it1;
-            for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-            {
-              unsigned long fidx1 = *it1;
-              MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-              
-              std::vector<unsigned long>::iterator it2;
-              for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-              {
-                unsigned long fidx2 = *it2;
-                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                MeshPoint p0, p1;
-
-                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                if (isect > 0)
-                { 
-                   // optimize cut line if distance to nearest point is too small
-                  float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
-                  MeshPoint np0 = p0, np1 = p1;
-                  int i;
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f1._aclPoints[i] - p0).Length();
-                    float d2 = (f1._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f1._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      p1 = f1._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
-
-                  // optimize cut line if distance to nearest point is too small
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f2._aclPoints[i] - p0).Length();
-                    float d2 = (f2._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f2._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      np1 = f2._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
+          CellPairs cell;
+          cell.x = gx1; cell.y = gy1; cell.z = gz1;
+          cells.push_back(cell);
+        }
+      }
+    }
+  }
+
+  // broad phase: collect the facet pairs with overlapping bounding boxes per grid cell
+  const MeshKernel& cutMesh0 = _cutMesh0;
+  const MeshKernel& cutMesh1 = _cutMesh1;
+  QtConcurrent::blockingMap(cells, [&grid1, &grid2, &cutMesh0, &cutMesh1](CellPairs& cell) {
+    std::vector<unsigned long> vecFacets2;
+    grid2.Inside(grid1.GetBoundBox(cell.x, cell.y, cell.z), vecFacets2);
+    if (vecFacets2.empty())
+      return;
+
+    std::set<unsigned long> vecFacets1;
+    grid1.GetElements(cell.x, cell.y, cell.z, vecFacets1);
+    for (std::set<unsigned long>::iterator it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
+    {
+      Base::BoundBox3f box1 = cutMesh0.GetFacet(*it1).GetBoundBox();
+      for (std::vector<unsigned long>::iterator it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
+      {
+        if (box1 && cutMesh1.GetFacet(*it2).GetBoundBox())
+          cell.pairs.push_back(std::make_pair(*it1, *it2));
+      }
+    }
+  });
 
-                  MeshPoint mp0 = np0;
-                  MeshPoint mp1 = np1;
+  // a facet pair can be found in several grid cells
+  std::vector<std::pair<unsigned long, unsigned long> > pairs;
+  for (std::vector<CellPairs>::iterator it = cells.begin(); it != cells.end(); ++it)
+  {
+    pairs.insert(pairs.end(), it->pairs.begin(), it->pairs.end());
+    std::vector<std::pair<unsigned long, unsigned long> >().swap(it->pairs);
+  }
+  int threads = std::max(1, QThread::idealThreadCount());
+  MeshCore::parallel_sort(pairs.begin(), pairs.end(), std::less<std::pair<unsigned long, unsigned long> >(), threads);
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
 
-                  if (mp0 != mp1)
-                  {
-                    facetsCuttingEdge0.insert(fidx1);
-                    facetsCuttingEdge1.insert(fidx2);
+  // narrow phase: intersect the facet pairs in parallel
+  std::vector<FacetCut> cuts(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); i++)
+  {
+    cuts[i].facet0 = pairs[i].first;
+    cuts[i].facet1 = pairs[i].second;
+    cuts[i].numPoints = 0;
+  }
+  std::vector<std::pair<unsigned long, unsigned long> >().swap(pairs);
 
-                    _cutPoints.insert(mp0);
-                    _cutPoints.insert(mp1);
+  QtConcurrent::blockingMap(cuts, [this](FacetCut& cut) {
+    CutFacets(cut);
+  });
 
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
+  // merge the results in a deterministic order
+  for (std::vector<FacetCut>::iterator it = cuts.begin(); it != cuts.end(); ++it)
+  {
+    unsigned long fidx1 = it->facet0;
+    unsigned long fidx2 = it->facet1;
+    if (it->numPoints == 2)
+    {
+      facetsCuttingEdge0.insert(fidx1);
+      facetsCuttingEdge1.insert(fidx2);
 
-                    _edges[Edge(mp0, mp1)] = EdgeInfo();
+      std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(it->pt0);
+      std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(it->pt1);
 
-                    _facet2points[0][fidx1].push_back(pit0.first);
-                    _facet2points[0][fidx1].push_back(pit1.first);
-                    _facet2points[1][fidx2].push_back(pit0.first);
-                    _facet2points[1][fidx2].push_back(pit1.first);
+      _edges[Edge(it->pt0, it->pt1)] = EdgeInfo();
 
-                  }
-                  else
-                  {
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
+      _facet2points[0][fidx1].push_back(pit0.first);
+      _facet2points[0][fidx1].push_back(pit1.first);
+      _facet2points[1][fidx2].push_back(pit0.first);
+      _facet2points[1][fidx2].push_back(pit1.first);
+    }
+    else if (it->numPoints == 1)
+    {
+      std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(it->pt0);
 
-                    // do not insert a facet when only one corner point cuts the edge
-                    // if (!((mp0 == f1._aclPoints[0]) || (mp0 == f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                    {
-                      facetsCuttingEdge0.insert(fidx1);
-                      _facet2points[0][fidx1].push_back(pit.first);
-                    }
+      facetsCuttingEdge0.insert(fidx1);
+      _facet2points[0][fidx1].push_back(pit.first);
 
-                    // if (!((mp0 == f2._aclPoints[0]) || (mp0 == f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                    {
-                      facetsCuttingEdge1.insert(fidx2);
-                      _facet2points[1][fidx2].push_back(pit.first);
-                    }
-                  }
-
-                 } // if (f1.IntersectWithFacet(f2, p0, p1))
-              } // for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-            } // for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-          } // if (vecFacets2.size() > 0)
-        } // if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
-      } // for (gz1 = 0; gz1 < ctGz1; gz1++)
-    } // for (gy1 = 0; gy1 < ctGy1; gy1++)
-  } // for (gx1 = 0; gx1 < ctGx1; gx1++)  
+      facetsCuttingEdge1.insert(fidx2);
+      _facet2points[1][fidx2].push_back(pit.first);
+    }
+  }
 }
 
-void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
+void SetOperations::CutFacets (FacetCut& cut) const
 {
-  // Triangulate Mesh 
-  std::map<unsigned long, std::list<std::set<MeshPoint>::iterator> >::iterator it1;
-  for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
-  {
-    std::vector<Vector3f> points;
-    std::set<MeshPoint>   pointsSet;
-
-    unsigned long fidx = it1->first;
-    MeshGeomFacet f = cutMesh.GetFacet(fidx);
+  MeshGeomFacet f1 = _cutMesh0.GetFacet(cut.facet0);
+  MeshGeomFacet f2 = _cutMesh1.GetFacet(cut.facet1);
+
+  // Reject separated facets with the filtered predicate. Coplanar facets are
+  // skipped as well because their intersection is not a line segment. The cut
+  // line is then given by the adjacent non-coplanar facets, and the regions
+  // coinciding with the other mesh are handled by CollectFacetVisitor.
+  if (PlaneSideFilter(f1, f2) >= 0 || PlaneSideFilter(f2, f1) >= 0)
+    return;
 
-    //if (side == 1)
-    //    _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0, 1, 1);
+  MeshPoint p0, p1;
+  int isect = f1.IntersectWithFacet(f2, p0, p1);
+  if (isect <= 0)
+    return;
 
-     // facet corner points
-    //const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-    int i;
-    for (i = 0; i < 3; i++)
+  // optimize cut line if distance to nearest point is too small
+  float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
+  MeshPoint np0 = p0, np1 = p1;
+  for (int i = 0; i < 3; i++)
+  {
+    float d1 = (f1._aclPoints[i] - p0).Length();
+    float d2 = (f1._aclPoints[i] - p1).Length();
+    if (d1 < minDist1)
     {
-      pointsSet.insert(f._aclPoints[i]);
-      points.push_back(f._aclPoints[i]);
+      minDist1 = d1;
+      np0 = f1._aclPoints[i];
     }
-    
-    // triangulated facets
-    std::list<std::set<MeshPoint>::iterator>::iterator it2;
-    for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+    if (d2 < minDist2)
     {
-      if (pointsSet.find(*(*it2)) == pointsSet.end())
-      {
-        pointsSet.insert(*(*it2));
-        points.push_back(*(*it2));
-      }
-
+      minDist2 = d2;
+      np1 = f1._aclPoints[i];
     }
+  }
 
-    Vector3f normal = f.GetNormal();
-    Vector3f base = points[0];
-    Vector3f dirX = points[1] - points[0];
-    dirX.Normalize();
-    Vector3f dirY = dirX % normal;
-
-    // project points to 2D plane
-    std::vector<Vector3f>::iterator it;
-    std::vector<Vector3f> vertices;
-    for (it = points.begin(); it != points.end(); ++it)
+  for (int i = 0; i < 3; i++)
+  {
+    float d1 = (f2._aclPoints[i] - p0).Length();
+    float d2 = (f2._aclPoints[i] - p1).Length();
+    if (d1 < minDist1)
     {
-      Vector3f pv = *it;
-      pv.TransformToCoordinateSystem(base, dirX, dirY);
-      vertices.push_back(pv);
+      minDist1 = d1;
+      np0 = f2._aclPoints[i];
     }
-
-    DelaunayTriangulator tria;
-    tria.SetPolygon(vertices);
-    tria.TriangulatePolygon();
-
-    std::vector<MeshFacet> facets = tria.GetFacets();
-    for (std::vector<MeshFacet>::iterator it = facets.begin(); it != facets.end(); ++it)
+    if (d2 < minDist2)
     {
-      if ((it->_aulPoints[0] == it->_aulPoints[1]) ||
-          (it->_aulPoints[1] == it->_aulPoints[2]) ||
-          (it->_aulPoints[2] == it->_aulPoints[0]))
-      { // two same triangle corner points
-        continue;
-      }
-  
-      MeshGeomFacet facet(points[it->_aulPoints[0]],
-                          points[it->_aulPoints[1]],
-                          points[it->_aulPoints[2]]);
-
-      //if (side == 1)
-      // _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
-
-      //if (facet.Area() < 0.0001f)
-      //{ // too small facet
-      //  continue;
-      //}
-
-      float dist0 = facet._aclPoints[0].DistanceToLine
-          (facet._aclPoints[1],facet._aclPoints[1] - facet._aclPoints[2]);
-      float dist1 = facet._aclPoints[1].DistanceToLine
-          (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[2]);
-      float dist2 = facet._aclPoints[2].DistanceToLine
-          (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[1]);
-
-      if ((dist0 < _minDistanceToPoint) ||
-          (dist1 < _minDistanceToPoint) ||
-          (dist2 < _minDistanceToPoint))
-      {
-        continue;
-      }
+      minDist2 = d2;
+      np1 = f2._aclPoints[i];
+    }
+  }
 
-      //dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-      //dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-      //dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+  cut.pt0 = np0;
+  cut.pt1 = np1;
+  cut.numPoints = (cut.pt0 != cut.pt1) ? 2 : 1;
+}
 
-      //if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 < _minDistanceToPoint))
-      //{
-      //  continue;
-      //}
+void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
+{
+  typedef std::map<unsigned long, std::list<std::set<MeshPoint>::iterator> >::iterator FacetPointsIter;
 
-      facet.CalcNormal();
-      if ((facet.GetNormal() * f.GetNormal()) < 0.0f)
-      { // adjust normal
-         std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-         facet.CalcNormal();
-      }
+  struct FacetTriangulation
+  {
+    FacetPointsIter facetPoints;
+    std::vector<MeshGeomFacet> facets;
+  };
 
+  std::vector<FacetTriangulation> triangulations;
+  triangulations.reserve(_facet2points[side].size());
+  for (FacetPointsIter it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
+  {
+    FacetTriangulation tria;
+    tria.facetPoints = it1;
+    triangulations.push_back(tria);
+  }
+
+  // triangulate the cut facets in parallel
+  QtConcurrent::blockingMap(triangulations, [this, &cutMesh](FacetTriangulation& tria) {
+    MeshGeomFacet f = cutMesh.GetFacet(tria.facetPoints->first);
+    TriangulateFacet(f, tria.facetPoints->second, tria.facets);
+  });
 
+  // register the new facets at the cut edges
+  for (std::vector<FacetTriangulation>::iterator it1 = triangulations.begin(); it1 != triangulations.end(); ++it1)
+  {
+    unsigned long fidx = it1->facetPoints->first;
+    for (std::vector<MeshGeomFacet>::iterator it = it1->facets.begin(); it != it1->facets.end(); ++it)
+    {
+      MeshGeomFacet& facet = *it;
       int j;
       for (j = 0; j < 3; j++)
       {
@@ -417,25 +512,103 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
 
         if (eit != _edges.end())
         {
-
           if (eit->second.fcounter[side] < 2)
           {
-            //if (side == 0)
-            //   _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
-
             eit->second.facet[side] = fidx;
             eit->second.facets[side][eit->second.fcounter[side]] = facet;
             eit->second.fcounter[side]++;
             facet.SetFlag(MeshFacet::MARKED); // set all facets connected to an edge: MARKED
-
           }
         }
       }
 
       _newMeshFacets[side].push_back(facet);
+    }
+  }
+}
+
+void SetOperations::TriangulateFacet (const MeshGeomFacet& f, const std::list<std::set<MeshPoint>::iterator>& cutPoints,
+                                      std::vector<MeshGeomFacet>& triangles) const
+{
+  std::vector<Vector3f> points;
+  std::set<MeshPoint>   pointsSet;
+
+  // facet corner points
+  int i;
+  for (i = 0; i < 3; i++)
+  {
+    pointsSet.insert(f._aclPoints[i]);
+    points.push_back(f._aclPoints[i]);
+  }
+
+  // triangulated facets
+  std::list<std::set<MeshPoint>::iterator>::const_iterator it2;
+  for (it2 = cutPoints.begin(); it2 != cutPoints.end(); ++it2)
+  {
+    if (pointsSet.find(*(*it2)) == pointsSet.end())
+    {
+      pointsSet.insert(*(*it2));
+      points.push_back(*(*it2));
+    }
+  }
+
+  Vector3f normal = f.GetNormal();
+  Vector3f base = points[0];
+  Vector3f dirX = points[1] - points[0];
+  dirX.Normalize();
+  Vector3f dirY = dirX % normal;
+
+  // project points to 2D plane
+  std::vector<Vector3f>::iterator it;
+  std::vector<Vector3f> vertices;
+  for (it = points.begin(); it != points.end(); ++it)
+  {
+    Vector3f pv = *it;
+    pv.TransformToCoordinateSystem(base, dirX, dirY);
+    vertices.push_back(pv);
+  }
+
+  DelaunayTriangulator tria;
+  tria.SetPolygon(vertices);
+  tria.TriangulatePolygon();
 
-    } // for (i = 0; i < (out->numberoftriangles * 3); i += 3)
-  } // for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
+  std::vector<MeshFacet> facets = tria.GetFacets();
+  for (std::vector<MeshFacet>::iterator it = facets.begin(); it != facets.end(); ++it)
+  {
+    if ((it->_aulPoints[0] == it->_aulPoints[1]) ||
+        (it->_aulPoints[1] == it->_aulPoints[2]) ||
+        (it->_aulPoints[2] == it->_aulPoints[0]))
+    { // two same triangle corner points
+      continue;
+    }
+
+    MeshGeomFacet facet(points[it->_aulPoints[0]],
+                        points[it->_aulPoints[1]],
+                        points[it->_aulPoints[2]]);
+
+    float dist0 = facet._aclPoints[0].DistanceToLine
+        (facet._aclPoints[1],facet._aclPoints[1] - facet._aclPoints[2]);
+    float dist1 = facet._aclPoints[1].DistanceToLine
+        (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[2]);
+    float dist2 = facet._aclPoints[2].DistanceToLine
+        (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[1]);
+
+    if ((dist0 < _minDistanceToPoint) ||
+        (dist1 < _minDistanceToPoint) ||
+        (dist2 < _minDistanceToPoint))
+    {
+      continue;
+    }
+
+    facet.CalcNormal();
+    if ((facet.GetNormal() * f.GetNormal()) < 0.0f)
+    { // adjust normal
+       std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+       facet.CalcNormal();
+    }
+
+    triangles.push_back(facet);
+  }
 }
 
 void SetOperations::CollectFacets (int side, float mult)
@@ -470,7 +643,7 @@ void SetOperations::CollectFacets (int side, float mult)
     { // Facet found, visit neighbours
       std::vector<unsigned long> facets;
       facets.push_back(itf - rFacets.begin()); // add seed facet
-      CollectFacetVisitor visitor(mesh, facets, _edges, side, mult, _builder); 
+      CollectFacetVisitor visitor(mesh, facets, _edges, side, mult, _operationType, _builder);
       mesh.VisitNeighbourFacets(visitor, itf - rFacets.begin());
       
       if (visitor._addFacets == 0)
@@ -494,12 +667,13 @@ void SetOperations::CollectFacets (int side, float mult)
 
 SetOperations::CollectFacetVisitor::CollectFacetVisitor (const MeshKernel& mesh, std::vector<unsigned long>& facets,
                                                          std::map<Edge, EdgeInfo>& edges, int side, float mult,
-                                                         Base::Builder3D& builder)
+                                                         OperationType opType, Base::Builder3D& builder)
   : _facets(facets)
   , _mesh(mesh)
   , _edges(edges)
   , _side(side)
   , _mult(mult)
+  , _operationType(opType)
   , _addFacets(-1)
   ,_builder(builder)
 {
@@ -533,20 +707,57 @@ bool SetOperations::CollectFacetVisitor::AllowVisit (const MeshFacet& rclFacet,
             if (_addFacets == -1) {
                 // determine if the facets should add or not only once
                 MeshGeomFacet facet = _mesh.GetFacet(rclFrom); // triangulated facet
-                MeshGeomFacet facetOther = it->second.facets[1-_side][0]; // triangulated facet from same edge and other mesh
-                Vector3f normalOther = facetOther.GetNormal();
-                //Vector3f normal = facet.GetNormal();
+                Vector3f normal = facet.GetNormal();
 
                 Vector3f edgeDir = it->first.pt1 - it->first.pt2;
                 Vector3f ocDir = (edgeDir % (facet.GetGravityPoint() - it->first.pt1)) % edgeDir;
                 ocDir.Normalize();
-                Vector3f ocDirOther = (edgeDir % (facetOther.GetGravityPoint() - it->first.pt1)) % edgeDir;
-                ocDirOther.Normalize();
 
-                //Vector3f dir = ocDir % normal;
-                //Vector3f dirOther = ocDirOther % normalOther;
-
-                bool match = ((ocDir * normalOther) * _mult) < 0.0f;
+                // Of the triangulated facets from same edge and other mesh take the one
+                // most inclined to this facet. A coplanar one can't tell the side, but
+                // if it covers this facet the whole region coincides with the other mesh.
+                int coplanar = 0; // 1: same orientation, -1: opposite orientation
+                int other = 0;
+                float maxDot = -1.0f;
+                for (int k = 0; k < it->second.fcounter[1-_side]; k++)
+                {
+                    const MeshGeomFacet& facetOther = it->second.facets[1-_side][k];
+                    Vector3f normalOther = facetOther.GetNormal();
+                    float cosAngle = normal * normalOther;
+                    if (std::fabs(cosAngle) > 1.0f - 1.0e-4f &&
+                        ocDir * (facetOther.GetGravityPoint() - it->first.pt1) > 0.0f)
+                    {
+                        coplanar = cosAngle > 0.0f ? 1 : -1;
+                        break;
+                    }
+                    float dot = std::fabs(ocDir * normalOther);
+                    if (dot > maxDot)
+                    {
+                        maxDot = dot;
+                        other = k;
+                    }
+                }
+
+                bool match;
+                if (coplanar != 0)
+                {
+                    // Keep such a region only from the first mesh: If both surfaces face
+                    // the same way it's on the boundary of the union, the intersection and
+                    // the inner part. If they face each other it only remains for the
+                    // difference and the outer part.
+                    if (_side != 0)
+                        match = false;
+                    else if (coplanar > 0)
+                        match = _operationType == Union || _operationType == Intersect ||
+                                _operationType == Inner;
+                    else
+                        match = _operationType == Difference || _operationType == Outer;
+                }
+                else
+                {
+                    Vector3f normalOther = it->second.facets[1-_side][other].GetNormal();
+                    match = ((ocDir * normalOther) * _mult) < 0.0f;
+                }
 
                 //if (matchCounter == 1)
                 //{
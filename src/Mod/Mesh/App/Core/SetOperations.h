@@ -151,10 +151,12 @@ private:
       std::map<Edge, EdgeInfo>   &_edges;
       int                         _side;
       float                       _mult;
+      OperationType               _operationType;
       int                         _addFacets; // 0: add facets to the result 1: do not add facets to the result
       Base::Builder3D& _builder;
 
-      CollectFacetVisitor (const MeshKernel& mesh, std::vector<unsigned long>& facets, std::map<Edge, EdgeInfo>& edges, int side, float mult, Base::Builder3D& builder);
+      CollectFacetVisitor (const MeshKernel& mesh, std::vector<unsigned long>& facets, std::map<Edge, EdgeInfo>& edges, int side, float mult,
+                           OperationType opType, Base::Builder3D& builder);
       bool Visit (const MeshFacet &rclFacet, const MeshFacet &rclFrom, unsigned long ulFInd, unsigned long ulLevel);
       bool AllowVisit (const MeshFacet& rclFacet, const MeshFacet& rclFrom, unsigned long ulFInd, unsigned long ulLevel, unsigned short neighbourIndex);
   };
@@ -170,10 +172,23 @@ private:
 
   std::vector<MeshGeomFacet> _newMeshFacets[2];
 
+  /** Result of intersecting two facets of the two meshes */
+  struct FacetCut
+  {
+    unsigned long facet0, facet1;
+    MeshPoint     pt0, pt1;
+    int           numPoints;
+  };
+
   /** Cut mesh 1 with mesh 2 */
   void Cut (std::set<unsigned long>& facetsNotCuttingEdge0, std::set<unsigned long>& facetsCuttingEdge1);
+  /** Intersect the two facets of \a cut and store the optimized cut line */
+  void CutFacets (FacetCut& cut) const;
   /** Trianglute each facets cut with its cutting points */
   void TriangulateMesh (const MeshKernel &cutMesh, int side);
+  /** Trianglute a single facet with its cutting points */
+  void TriangulateFacet (const MeshGeomFacet& facet, const std::list<std::set<MeshPoint>::iterator>& cutPoints,
+                         std::vector<MeshGeomFacet>& facets) const;
   /** search facets for adding (with region growing) */
   void CollectFacets (int side, float mult);
   /** close gap in the mesh */
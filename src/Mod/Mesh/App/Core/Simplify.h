@@ -9,6 +9,7 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked flag to vertices that must neither be moved nor removed
 
 #include <vector>
 #include <Base/Vector3D.h>
@@ -84,7 +85,7 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;};
     struct Ref { int tid,tvertex; }; 
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
@@ -198,6 +199,10 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices are kept as they are
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
                     calculate_error(i0,i1,p);
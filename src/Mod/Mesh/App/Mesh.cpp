@@ -995,6 +995,14 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimateBlocks(float fTolerance, float fReduction, int blocks, float featureAngle)
+{
+    MeshCore::MeshBlockSimplify dm(this->_kernel);
+    dm.SetBlocks(blocks);
+    dm.SetFeatureAngle(featureAngle);
+    dm.simplify(fTolerance, fReduction);
+}
+
 Base::Vector3d MeshObject::getPointNormal(unsigned long index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -1803,7 +1811,8 @@ MeshObject* MeshObject::meshFromSegment(const std::vector<unsigned long>& indice
 }
 
 std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type,
-                                                   float dev, unsigned long minFacets) const
+                                                   float dev, unsigned long minFacets,
+                                                   bool parallel) const
 {
     std::vector<Segment> segm;
     if (this->_kernel.CountFacets() == 0)
@@ -1832,7 +1841,10 @@ std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type
     if (surf.get()) {
         std::vector<MeshCore::MeshSurfaceSegmentPtr> surfaces;
         surfaces.push_back(surf);
-        finder.FindSegments(surfaces);
+        if (parallel)
+            finder.FindSegmentsParallel(surfaces);
+        else
+            finder.FindSegments(surfaces);
 
         const std::vector<MeshCore::MeshSegment>& data = surf->GetSegments();
         for (std::vector<MeshCore::MeshSegment>::const_iterator it = data.begin(); it != data.end(); ++it) {
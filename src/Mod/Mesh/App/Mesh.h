@@ -218,6 +218,8 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    /// Decimates the mesh block-wise in parallel and keeps boundary and feature edges.
+    void decimateBlocks(float fTolerance, float fReduction, int blocks, float featureAngle);
     Base::Vector3d getPointNormal(unsigned long) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
@@ -302,7 +304,8 @@ public:
     const Segment& getSegment(unsigned long) const;
     Segment& getSegment(unsigned long);
     MeshObject* meshFromSegment(const std::vector<unsigned long>&) const;
-    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets) const;
+    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets,
+                                           bool parallel = false) const;
     //@}
 
     /** @name Primitives */
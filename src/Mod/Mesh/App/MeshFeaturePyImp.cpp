@@ -23,6 +23,8 @@
 #include "PreCompiled.h"
 
 #include <Base/Console.h>
+#include <Base/Converter.h>
+#include <Base/GeometryPyCXX.h>
 #include <Base/Handle.h>
 
 #include "Core/Evaluation.h"
@@ -220,6 +222,36 @@ PyObject*  MeshFeaturePy::removeInvalidPoints(PyObject *args)
     Py_Return;
 }
 
+PyObject*  MeshFeaturePy::setPoints(PyObject *args)
+{
+    PyObject* list;
+    if (!PyArg_ParseTuple(args, "O", &list))
+        return NULL;
+
+    PY_TRY {
+        Mesh::Feature* obj = getFeaturePtr();
+        const MeshObject& mesh = obj->Mesh.getValue();
+        Base::Matrix4D mat = mesh.getTransform();
+        mat.inverse();
+        unsigned long countPoints = mesh.countPoints();
+
+        std::vector<std::pair<unsigned long, Base::Vector3f> > points;
+        Py::Sequence seq(list);
+        for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+            Py::Tuple item(*it);
+            long index = static_cast<long>(Py::Long(item.getItem(0)));
+            if (index < 0 || static_cast<unsigned long>(index) >= countPoints)
+                throw Py::IndexError("Point index out of range");
+            Base::Vector3d pnt = mat * Py::Vector(item.getItem(1)).toVector();
+            points.push_back(std::make_pair(static_cast<unsigned long>(index), Base::convertTo<Base::Vector3f>(pnt)));
+        }
+
+        obj->Mesh.setPointIndices(points);
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject *MeshFeaturePy::getCustomAttributes(const char* /*attr*/) const
 {
     return 0;
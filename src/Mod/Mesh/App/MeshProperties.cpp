@@ -428,6 +428,7 @@ void PropertyCurvatureList::Paste(const App::Property &from)
 
 PropertyMeshKernel::PropertyMeshKernel()
   : _meshObject(new MeshObject()), meshPyObject(0)
+  , _pendingPoints(0), _pendingReplace(false), _isDelta(false)
 {
     // Note: Normally this property is a member of a document object, i.e. the setValue()
     // method gets called in the constructor of a sublcass of DocumentObject, e.g. Mesh::Feature.
@@ -450,7 +451,9 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // use the tmp. object to guarantee that the referenced mesh is not destroyed
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
+    _pendingReplace = true;
     aboutToSetValue();
+    _pendingReplace = false;
     _meshObject = mesh;
     hasSetValue();
 }
@@ -507,6 +510,9 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 {
     unsigned int size = 0;
     size += _meshObject->getMemSize();
+    size += _deltaPoints.size() * sizeof(std::pair<unsigned long, Base::Vector3f>);
+    if (_meshSnapshot)
+        size += _meshSnapshot->GetMemSize();
     
     return size;
 }
@@ -531,7 +537,9 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned long, Base::Vector3f> >& inds)
 {
+    _pendingPoints = &inds;
     aboutToSetValue();
+    _pendingPoints = 0;
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
@@ -634,9 +642,76 @@ App::Property *PropertyMeshKernel::Copy(void) const
 
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
+    const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
+    if (prop._isDelta) {
+        // restore the recorded points only, this creates a partial record
+        // for the opposite direction, too
+        setPointIndices(prop._deltaPoints);
+        return;
+    }
+
     // Note: Copy the content, do NOT reference the same mesh object
     aboutToSetValue();
-    const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
     *(this->_meshObject) = *(prop._meshObject);
+    if (prop._meshSnapshot) {
+        // the mesh object of the record only keeps the placement
+        MeshCore::MeshKernel kernel;
+        prop._meshSnapshot->GetKernel(kernel);
+        this->_meshObject->getKernel().Swap(kernel);
+    }
     hasSetValue();
 }
+
+App::Property *PropertyMeshKernel::CopyOnChange(void) const
+{
+    if (_pendingReplace) {
+        // The mesh object gets replaced, not modified, so it can be shared
+        PropertyMeshKernel *prop = new PropertyMeshKernel();
+        prop->_meshObject = this->_meshObject;
+        return prop;
+    }
+
+    if (_pendingPoints) {
+        PropertyMeshKernel *prop = new PropertyMeshKernel();
+        prop->_isDelta = true;
+        MergeDelta(*prop);
+        return prop;
+    }
+
+    // Segments refer to the facets of the mesh kernel and are not stored by
+    // the snapshot
+    const MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    if (_meshObject->countSegments() == 0 && MeshCore::MeshKernelSnapshot::IsCompatible(kernel)) {
+        PropertyMeshKernel *prop = new PropertyMeshKernel();
+        prop->_meshObject->setTransform(_meshObject->getTransform());
+        prop->_meshSnapshot.reset(new MeshCore::MeshKernelSnapshot(kernel));
+        return prop;
+    }
+
+    return Copy();
+}
+
+bool PropertyMeshKernel::isDelta(void) const
+{
+    return _isDelta;
+}
+
+bool PropertyMeshKernel::MergeDelta(App::Property &delta) const
+{
+    PropertyMeshKernel* prop = dynamic_cast<PropertyMeshKernel*>(&delta);
+    if (!_pendingPoints || !prop || !prop->_isDelta)
+        return false;
+
+    // keep the oldest coordinate of points that have already been recorded
+    std::set<unsigned long> recorded;
+    for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = prop->_deltaPoints.begin(); it != prop->_deltaPoints.end(); ++it)
+        recorded.insert(it->first);
+
+    const MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    unsigned long countPoints = kernel.CountPoints();
+    for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = _pendingPoints->begin(); it != _pendingPoints->end(); ++it) {
+        if (it->first < countPoints && recorded.insert(it->first).second)
+            prop->_deltaPoints.push_back(std::make_pair(it->first, Base::Vector3f(kernel.GetPoint(it->first))));
+    }
+    return true;
+}
@@ -24,6 +24,7 @@
 #ifndef MESH_MESHPROPERTIES_H
 #define MESH_MESHPROPERTIES_H
 
+#include <memory>
 #include <vector>
 #include <list>
 #include <set>
@@ -37,6 +38,7 @@
 #include <App/PropertyStandard.h>
 #include <App/PropertyGeo.h>
 
+#include "Core/KernelSnapshot.h"
 #include "Core/MeshKernel.h"
 #include "Mesh.h"
 
@@ -249,9 +251,30 @@ public:
     void Paste(const App::Property &from);
     //@}
 
+    /** @name Undo/Redo */
+    //@{
+    /** Returns a partial record with the old coordinates if only some points
+     * are about to be moved, see setPointIndices(). If the whole mesh object
+     * gets replaced, see setValuePtr(), the record shares the old mesh object.
+     * Otherwise the record keeps a MeshCore::MeshKernelSnapshot of the mesh.
+     */
+    App::Property *CopyOnChange(void) const;
+    bool isDelta(void) const;
+    bool MergeDelta(App::Property &delta) const;
+    //@}
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject;
+
+    // pending change, only set while calling aboutToSetValue()
+    const std::vector<std::pair<unsigned long, Base::Vector3f> >* _pendingPoints;
+    bool _pendingReplace;
+    // old point coordinates if this is a partial undo record
+    std::vector<std::pair<unsigned long, Base::Vector3f> > _deltaPoints;
+    bool _isDelta;
+    // snapshot of the mesh if this is a full undo record
+    std::unique_ptr<MeshCore::MeshKernelSnapshot> _meshSnapshot;
 };
 
 } // namespace Mesh
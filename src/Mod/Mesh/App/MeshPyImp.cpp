@@ -1734,6 +1734,17 @@ PyObject*  MeshPy::decimate(PyObject *args)
         Py_Return;
     }
 
+    PyErr_Clear();
+    int blocks;
+    float fAngle = 60.0f;
+    if (PyArg_ParseTuple(args, "ffi|f", &fTol,&fRed,&blocks,&fAngle)) {
+        PY_TRY {
+            getMeshObjectPtr()->decimateBlocks(fTol, fRed, blocks, Base::toRadians<float>(fAngle));
+        } PY_CATCH;
+
+        Py_Return;
+    }
+
     PyErr_Clear();
     int targetSize;
     if (PyArg_ParseTuple(args, "i", &targetSize)) {
@@ -1744,7 +1755,7 @@ PyObject*  MeshPy::decimate(PyObject *args)
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float, [blocks=int, featureAngle=float]) or decimate(targetSize=int)");
     return nullptr;
 }
 
@@ -1848,7 +1859,8 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
     char* type;
     float dev;
     unsigned long minFacets=0;
-    if (!PyArg_ParseTuple(args, "sf|k",&type,&dev,&minFacets))
+    PyObject* parallel = Py_False;
+    if (!PyArg_ParseTuple(args, "sf|kO!",&type,&dev,&minFacets,&PyBool_Type,&parallel))
         return NULL;
 
     Mesh::MeshObject::GeometryType geoType;
@@ -1868,7 +1880,7 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
 
     Mesh::MeshObject* mesh = getMeshObjectPtr();
     std::vector<Mesh::Segment> segments = mesh->getSegmentsOfType
-        (geoType, dev, minFacets);
+        (geoType, dev, minFacets, PyObject_IsTrue(parallel) ? true : false);
 
     Py::List s;
     for (std::vector<Mesh::Segment>::iterator it = segments.begin(); it != segments.end(); ++it) {
@@ -1890,7 +1902,8 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
 PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
 {
     PyObject* l;
-    if (!PyArg_ParseTuple(args, "O",&l))
+    PyObject* parallel = Py_False;
+    if (!PyArg_ParseTuple(args, "O|O!",&l,&PyBool_Type,&parallel))
         return NULL;
 
     const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
@@ -1914,7 +1927,10 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(meshCurv.GetCurvature(), num, tol1, tol2, c1, c2));
     }
 
-    finder.FindSegments(segm);
+    if (PyObject_IsTrue(parallel))
+        finder.FindSegmentsParallel(segm);
+    else
+        finder.FindSegments(segm);
 
     Py::List list;
     for (std::vector<MeshCore::MeshSurfaceSegmentPtr>::iterator segmIt = segm.begin(); segmIt != segm.end(); ++segmIt) {
@@ -173,6 +173,261 @@ class LoadMeshInThreadsCases(unittest.TestCase):
         pass
 
 
+class DecimationCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createSphere(10.0, 50)
+
+    def testBlockDecimation(self):
+        count = self.mesh.CountFacets
+        self.mesh.decimate(0.5, 0.5, 2)
+        self.assertLess(self.mesh.CountFacets, count)
+
+    def testBoundaryPreserved(self):
+        box = Mesh.createBox(10.0, 10.0, 10.0)
+        count = box.CountFacets
+        box.decimate(0.5, 0.9, 2, 30)
+        self.assertEqual(box.CountFacets, count)
+
+    def countOpenEdges(self, mesh):
+        edges = {}
+        for facet in mesh.Topology[1]:
+            for i in range(3):
+                edge = tuple(sorted((facet[i], facet[(i + 1) % 3])))
+                edges[edge] = edges.get(edge, 0) + 1
+        return len([e for e in edges.values() if e == 1])
+
+    def testBlockSeamsClosed(self):
+        # the seams between the blocks must be stitched without gaps
+        self.mesh.decimate(0.5, 0.5, 3)
+        self.assertEqual(self.countOpenEdges(self.mesh), 0)
+        self.assertFalse(self.mesh.hasNonManifolds())
+        self.assertEqual(self.mesh.countComponents(), 1)
+
+        triangles = []
+        for i in range(20):
+            for j in range(20):
+                a = FreeCAD.Vector(i, j, 0)
+                b = FreeCAD.Vector(i + 1, j, 0)
+                c = FreeCAD.Vector(i + 1, j + 1, 0)
+                d = FreeCAD.Vector(i, j + 1, 0)
+                triangles += [[a, b, c], [a, c, d]]
+        grid = Mesh.Mesh(triangles)
+        count = grid.CountFacets
+        border = self.countOpenEdges(grid)
+        grid.decimate(0.5, 0.5, 3)
+        self.assertLess(grid.CountFacets, count)
+        self.assertEqual(self.countOpenEdges(grid), border)
+
+    def testBlockGeometricError(self):
+        # the tolerance bounds the squared distance of a moved point to the
+        # planes of the original facets, which are close to the sphere
+        tolerance = 0.25
+        self.mesh.decimate(tolerance, 0.5, 3)
+        bound = math.sqrt(tolerance) + 0.05
+        for p in self.mesh.Points:
+            self.assertLess(abs(p.Vector.Length - 10.0), bound)
+
+    def tearDown(self):
+        pass
+
+
+class SegmentationCases(unittest.TestCase):
+    def setUp(self):
+        # two planar grids meeting at a right angle, big enough that the
+        # parallel search tests whole fronts in several threads
+        self.size = 40
+        triangles = []
+        for i in range(self.size):
+            for j in range(self.size):
+                a = FreeCAD.Vector(i, j, 0)
+                b = FreeCAD.Vector(i + 1, j, 0)
+                c = FreeCAD.Vector(i + 1, j + 1, 0)
+                d = FreeCAD.Vector(i, j + 1, 0)
+                triangles += [[a, b, c], [a, c, d]]
+                a = FreeCAD.Vector(0, j, i + 1)
+                b = FreeCAD.Vector(0, j, i)
+                c = FreeCAD.Vector(0, j + 1, i)
+                d = FreeCAD.Vector(0, j + 1, i + 1)
+                triangles += [[a, b, c], [a, c, d]]
+        self.mesh = Mesh.Mesh(triangles)
+
+    def sortedSegments(self, segments):
+        return sorted([sorted(s) for s in segments])
+
+    def testParallelCurvature(self):
+        p = (0.0, 0.0, 0.1, 0.1, 2)
+        serial = self.mesh.getSegmentsByCurvature([p])
+        parallel = self.mesh.getSegmentsByCurvature([p], True)
+        self.assertTrue(len(serial) > 0)
+        self.assertEqual(self.sortedSegments(serial), self.sortedSegments(parallel))
+
+    def testParallelPlanes(self):
+        serial = self.mesh.getSegmentsOfType("Plane", 0.01, 2)
+        parallel = self.mesh.getSegmentsOfType("Plane", 0.01, 2, True)
+        self.assertEqual(len(serial), 2)
+        self.assertEqual([len(s) for s in serial], [2 * self.size * self.size] * 2)
+        self.assertEqual(self.sortedSegments(serial), self.sortedSegments(parallel))
+
+    def tearDown(self):
+        pass
+
+
+class SetOperationsCases(unittest.TestCase):
+    def setUp(self):
+        self.sphere1 = Mesh.createSphere(10.0, 50)
+        self.sphere2 = Mesh.createSphere(10.0, 50)
+        self.sphere2.translate(5.0, 0.0, 0.0)
+
+    def testUnite(self):
+        result = self.sphere1.unite(self.sphere2)
+        self.assertGreater(result.CountFacets, 0)
+
+    def testIntersect(self):
+        result = self.sphere1.intersect(self.sphere2)
+        self.assertGreater(result.CountFacets, 0)
+
+    def testSeparated(self):
+        self.sphere2.translate(50.0, 0.0, 0.0)
+        result = self.sphere1.unite(self.sphere2)
+        self.assertEqual(result.CountFacets, self.sphere1.CountFacets + self.sphere2.CountFacets)
+
+    def checkSolid(self, mesh):
+        self.assertTrue(mesh.isSolid())
+        self.assertFalse(mesh.hasNonManifolds())
+
+    def testVolumes(self):
+        union = self.sphere1.unite(self.sphere2)
+        inter = self.sphere1.intersect(self.sphere2)
+        diff = self.sphere1.subtract(self.sphere2)
+        self.checkSolid(union)
+        self.checkSolid(inter)
+        self.checkSolid(diff)
+
+        # the results are made of the facets of both spheres, so the
+        # volumes add up like the ones of the exact spheres
+        vol1 = abs(self.sphere1.Volume)
+        vol2 = abs(self.sphere2.Volume)
+        self.assertGreater(abs(inter.Volume), 0.0)
+        self.assertAlmostEqual(abs(union.Volume) + abs(inter.Volume), vol1 + vol2, delta=0.01 * vol1)
+        self.assertAlmostEqual(abs(diff.Volume) + abs(inter.Volume), vol1, delta=0.01 * vol1)
+
+    def testCoplanar(self):
+        # the top and bottom faces of both boxes lie in the same planes
+        box1 = Mesh.createBox(10.0, 10.0, 10.0)
+        box2 = Mesh.createBox(10.0, 10.0, 10.0)
+        box2.translate(5.0, 5.0, 0.0)
+
+        union = box1.unite(box2)
+        self.checkSolid(union)
+        self.assertAlmostEqual(abs(union.Volume), 1750.0, delta=0.1)
+
+        inter = box1.intersect(box2)
+        self.checkSolid(inter)
+        self.assertAlmostEqual(abs(inter.Volume), 250.0, delta=0.1)
+
+        diff = box1.subtract(box2)
+        self.checkSolid(diff)
+        self.assertAlmostEqual(abs(diff.Volume), 750.0, delta=0.1)
+
+    def testTouching(self):
+        # the small box stands on the top face of the big one
+        box1 = Mesh.createBox(10.0, 10.0, 10.0)
+        box2 = Mesh.createBox(4.0, 4.0, 4.0)
+        box2.translate(0.0, 0.0, 7.0)
+
+        union = box1.unite(box2)
+        self.checkSolid(union)
+        self.assertAlmostEqual(abs(union.Volume), 1064.0, delta=0.1)
+
+        inter = box1.intersect(box2)
+        self.assertAlmostEqual(abs(inter.Volume), 0.0, delta=0.1)
+
+        diff = box1.subtract(box2)
+        self.checkSolid(diff)
+        self.assertAlmostEqual(abs(diff.Volume), 1000.0, delta=0.1)
+
+    def tearDown(self):
+        pass
+
+
+class UndoRedoCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshUndoRedo")
+        self.doc.UndoMode = 1
+        self.feature = self.doc.addObject("Mesh::Feature", "Mesh")
+        mesh = Mesh.createSphere(10.0, 20)
+        mesh.Placement = FreeCAD.Placement(FreeCAD.Vector(1, 2, 3), FreeCAD.Rotation())
+        self.feature.Mesh = mesh
+
+    def testReplaceMesh(self):
+        # the undo record keeps a snapshot of the old mesh
+        old = self.feature.Mesh.copy()
+        self.doc.openTransaction("Replace")
+        self.feature.Mesh = Mesh.createBox(10.0, 10.0, 10.0)
+        self.doc.commitTransaction()
+        new = self.feature.Mesh.copy()
+
+        self.doc.undo()
+        self.assertEqual(self.feature.Mesh.Topology, old.Topology)
+        self.assertEqual(self.feature.Mesh.Placement, old.Placement)
+        self.assertEqual(self.feature.Mesh.CountFacets, old.CountFacets)
+        self.assertTrue(self.feature.Mesh.isSolid())
+
+        self.doc.redo()
+        self.assertEqual(self.feature.Mesh.Topology, new.Topology)
+        self.assertEqual(self.feature.Mesh.Placement, new.Placement)
+
+    def testMovePoints(self):
+        # the undo record only keeps the old positions of the moved points
+        old = self.feature.Mesh.copy()
+        self.doc.openTransaction("Move")
+        self.feature.setPoints([(0, FreeCAD.Vector(0, 0, 20)), (5, FreeCAD.Vector(1, 2, 30))])
+        self.doc.commitTransaction()
+        new = self.feature.Mesh.copy()
+        self.assertNotEqual(new.Topology, old.Topology)
+
+        self.doc.undo()
+        self.assertEqual(self.feature.Mesh.Topology, old.Topology)
+
+        self.doc.redo()
+        self.assertEqual(self.feature.Mesh.Topology, new.Topology)
+
+    def testMovePointsTwice(self):
+        # the second change extends the record of the first one
+        old = self.feature.Mesh.copy()
+        self.doc.openTransaction("Move")
+        self.feature.setPoints([(0, FreeCAD.Vector(0, 0, 20)), (5, FreeCAD.Vector(1, 2, 30))])
+        self.feature.setPoints([(5, FreeCAD.Vector(1, 2, 40)), (7, FreeCAD.Vector(3, 2, 1))])
+        self.doc.commitTransaction()
+        new = self.feature.Mesh.copy()
+
+        self.doc.undo()
+        self.assertEqual(self.feature.Mesh.Topology, old.Topology)
+
+        self.doc.redo()
+        self.assertEqual(self.feature.Mesh.Topology, new.Topology)
+
+    def testMovePointsThenReplace(self):
+        # the partial record cannot hold the new mesh and becomes a full copy
+        old = self.feature.Mesh.copy()
+        self.doc.openTransaction("Move")
+        self.feature.setPoints([(0, FreeCAD.Vector(0, 0, 20))])
+        self.feature.setPoints([(5, FreeCAD.Vector(1, 2, 30))])
+        self.feature.Mesh = Mesh.createBox(10.0, 10.0, 10.0)
+        self.doc.commitTransaction()
+        new = self.feature.Mesh.copy()
+
+        self.doc.undo()
+        self.assertEqual(self.feature.Mesh.Topology, old.Topology)
+        self.assertEqual(self.feature.Mesh.Placement, old.Placement)
+
+        self.doc.redo()
+        self.assertEqual(self.feature.Mesh.Topology, new.Topology)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("MeshUndoRedo")
+
+
 class PolynomialFitCases(unittest.TestCase):
     def setUp(self):
         pass
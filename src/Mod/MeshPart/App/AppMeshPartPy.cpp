@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 # include <BRepBuilderAPI_MakePolygon.hxx>
 # include <TopoDS.hxx>
+# include <TopExp_Explorer.hxx>
 #endif
 
 #include <CXX/Extensions.hxx>
@@ -80,6 +81,16 @@ public:
             "projectShapeOnMesh(Shape, Mesh, Vector) -> list of polygons\n"
             "projectShapeOnMesh(list of polygons, Mesh, Vector) -> list of polygons\n"
         );
+        add_keyword_method("projectCurvesOnMesh",&Module::projectCurvesOnMesh,
+            "Projects all edges of a shape onto the nearest points of a mesh.\n"
+            "The edges are projected in parallel.\n"
+            "projectCurvesOnMesh(Shape, Mesh, MaxDistance=0, Deflection=0) -> list of (points, facet indices)\n"
+            "\n"
+            "Args:\n"
+            "    MaxDistance (optional, float) - skip points farther away from the mesh, 0 for no limit\n"
+            "    Deflection (optional, float) - sampling deflection of the edges, 0 for a tenth of\n"
+            "        the average edge length of the mesh\n"
+        );
         add_varargs_method("projectPointsOnMesh",&Module::projectPointsOnMesh,
             "Projects points onto a mesh with a given direction\n"
             "and tolerance."
@@ -101,7 +112,8 @@ public:
             "                         AngularDeflection=0.5,\n"
             "                         Relative=False,"
             "                         Segments=False,\n"
-            "                         GroupColors=[])\n"
+            "                         GroupColors=[],\n"
+            "                         Incremental=False)\n"
             "    meshFromShape(Shape, MaxLength)\n"
             "    meshFromShape(Shape, MaxArea)\n"
             "    meshFromShape(Shape, LocalLength)\n"
@@ -127,6 +139,8 @@ public:
             "    AngularDeflection (optional, float)\n"
             "    Segments (optional, boolean)\n"
             "    GroupColors (optional, list of (Red, Green, Blue) tuples)\n"
+            "    Incremental (optional, boolean) - mesh the faces independently and\n"
+            "        reuse the meshes of faces that did not change since the last call\n"
             "    MaxLength (required, float)\n"
             "    MaxArea (required, float)\n"
             "    LocalLength (required, float)\n"
@@ -140,6 +154,16 @@ public:
             "    SegPerEdge (optional, float)\n"
             "    SegPerRadius (optional, float)\n"
         );
+        add_varargs_method("getIncrementalCacheInfo",&Module::getIncrementalCacheInfo,
+            "getIncrementalCacheInfo() -- Returns a dict with the statistics of the face mesh cache\n"
+            "used by meshFromShape(..., Incremental=True)\n"
+            "\n"
+            "* Entries: number of cached face meshes\n"
+            "* MemSize: estimated memory used by the cached face meshes in bytes\n"
+            "* MemLimit: memory budget in bytes\n"
+            "* LastFaces: number of faces of the shape of the last call\n"
+            "* LastMeshed: number of faces meshed by the last call, the others came from the cache\n"
+        );
         initialize("This module is the MeshPart module."); // register with Python
     }
 
@@ -370,6 +394,48 @@ private:
                             "Shape, Mesh, Vector or\n"
                             "Polygons, Mesh, Vector\n");
     }
+    Py::Object projectCurvesOnMesh(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        static char* kwds_curves[] = {"Shape", "Mesh", "MaxDistance", "Deflection", NULL};
+        PyObject *s, *m;
+        double maxDist = 0;
+        double deflection = 0;
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
+                                         "O!O!|dd", kwds_curves,
+                                         &Part::TopoShapePy::Type, &s,
+                                         &Mesh::MeshPy::Type, &m,
+                                         &maxDist, &deflection))
+            throw Py::Exception();
+
+        TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
+        const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
+        MeshCore::MeshKernel kernel(mesh->getKernel());
+        kernel.Transform(mesh->getTransform());
+
+        std::vector<TopoDS_Edge> edges;
+        for (TopExp_Explorer xp(shape, TopAbs_EDGE); xp.More(); xp.Next())
+            edges.push_back(TopoDS::Edge(xp.Current()));
+
+        MeshProjection proj(kernel);
+        std::vector<MeshProjection::ProjectedCurve> curves;
+        proj.projectCurvesToMesh(edges, static_cast<float>(deflection), static_cast<float>(maxDist), curves);
+
+        Py::List list;
+        for (const auto& it : curves) {
+            Py::List poly;
+            for (const auto& jt : it.points)
+                poly.append(Py::Vector(jt));
+            Py::List indices;
+            for (auto jt : it.facets)
+                indices.append(Py::Long(static_cast<long>(jt)));
+            Py::Tuple item(2);
+            item.setItem(0, poly);
+            item.setItem(1, indices);
+            list.append(item);
+        }
+
+        return list;
+    }
     Py::Object projectPointsOnMesh(const Py::Tuple& args)
     {
         PyObject *seq, *m, *v;
@@ -478,17 +544,19 @@ private:
         PyObject *shape;
 
         static char* kwds_lindeflection[] = {"Shape", "LinearDeflection", "AngularDeflection",
-                                             "Relative", "Segments", "GroupColors", NULL};
+                                             "Relative", "Segments", "GroupColors", "Incremental", NULL};
         PyErr_Clear();
         double lindeflection=0;
         double angdeflection=0.5;
         PyObject* relative = Py_False;
         PyObject* segment = Py_False;
         PyObject* groupColors = 0;
-        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!O", kwds_lindeflection,
+        PyObject* incremental = Py_False;
+        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!OO!", kwds_lindeflection,
                                         &(Part::TopoShapePy::Type), &shape, &lindeflection,
                                         &angdeflection, &(PyBool_Type), &relative,
-                                        &(PyBool_Type), &segment, &groupColors)) {
+                                        &(PyBool_Type), &segment, &groupColors,
+                                        &(PyBool_Type), &incremental)) {
             MeshPart::Mesher mesher(static_cast<Part::TopoShapePy*>(shape)->getTopoShapePtr()->getShape());
             mesher.setMethod(MeshPart::Mesher::Standard);
             mesher.setDeflection(lindeflection);
@@ -496,6 +564,7 @@ private:
             mesher.setRegular(true);
             mesher.setRelative(PyObject_IsTrue(relative) ? true : false);
             mesher.setSegments(PyObject_IsTrue(segment) ? true : false);
+            mesher.setIncremental(PyObject_IsTrue(incremental) ? true : false);
             if (groupColors) {
                 Py::Sequence list(groupColors);
                 std::vector<uint32_t> colors;
@@ -624,6 +693,19 @@ private:
 
         throw Py::Exception(Base::BaseExceptionFreeCADError,"Wrong arguments");
     }
+    Py::Object getIncrementalCacheInfo(const Py::Tuple& args)
+    {
+        if (!PyArg_ParseTuple(args.ptr(), ""))
+            throw Py::Exception();
+        MeshPart::Mesher::IncrementalCacheInfo info = MeshPart::Mesher::getIncrementalCacheInfo();
+        Py::Dict dict;
+        dict.setItem("Entries", Py::Long(static_cast<unsigned long>(info.entries)));
+        dict.setItem("MemSize", Py::Long(static_cast<unsigned long>(info.memSize)));
+        dict.setItem("MemLimit", Py::Long(static_cast<unsigned long>(info.memLimit)));
+        dict.setItem("LastFaces", Py::Long(static_cast<unsigned long>(info.lastFaces)));
+        dict.setItem("LastMeshed", Py::Long(static_cast<unsigned long>(info.lastMeshed)));
+        return dict;
+    }
 };
 
 PyObject* initModule()
@@ -32,6 +32,7 @@
 # include <BRepBuilderAPI_MakeVertex.hxx>
 # include <BRepExtrema_DistShapeShape.hxx>
 # include <GCPnts_AbscissaPoint.hxx>
+# include <GCPnts_TangentialDeflection.hxx>
 # include <GCPnts_UniformDeflection.hxx>
 # include <GCPnts_UniformAbscissa.hxx>
 # include <gp_Pln.hxx>
@@ -43,8 +44,12 @@
 # include <BRep_Tool.hxx>
 # include <GeomAPI_IntCS.hxx>
 # include <Standard_Failure.hxx>
+# include <functional>
+# include <numeric>
 #endif
 
+#include <QtConcurrentMap>
+
 
 #include "MeshAlgos.h"
 #include "CurveProjector.h"
@@ -844,6 +849,102 @@ void MeshProjection::projectToMesh (const TopoDS_Shape &aShape, float fMaxDist,
     }
 }
 
+void MeshProjection::projectCurvesToMesh(const std::vector<TopoDS_Edge>& aEdges, float fDeflection, float fMaxDist,
+                                         std::vector<ProjectedCurve>& rCurves) const
+{
+    rCurves.clear();
+    rCurves.resize(aEdges.size());
+    if (_rcMesh.CountFacets() == 0)
+        return;
+
+    // the grid is shared by all curves and only read while projecting
+    MeshAlgorithm clAlg(_rcMesh);
+    float fAvgLen = clAlg.GetAverageEdgeLength();
+    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    const MeshCore::MeshFacetArray& facets = _rcMesh.GetFacets();
+    if (fDeflection <= 0)
+        fDeflection = 0.1f*fAvgLen;
+
+    // two facets touch if they share a corner
+    auto touch = [&facets](unsigned long f0, unsigned long f1) {
+        if (f0 == f1)
+            return true;
+        for (int i=0; i<3; i++) {
+            for (int j=0; j<3; j++) {
+                if (facets[f0]._aulPoints[i] == facets[f1]._aulPoints[j])
+                    return true;
+            }
+        }
+        return false;
+    };
+
+    struct Sample {
+        Base::Vector3f cCurvePt, cPt;
+        unsigned long ulFacet;
+        double fParam;
+        bool bHit;
+    };
+
+    std::vector<std::size_t> indices(aEdges.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](std::size_t index) {
+        const TopoDS_Edge& aEdge = aEdges[index];
+        if (BRep_Tool::Degenerated(aEdge))
+            return;
+
+        MeshAlgorithm cAlg(_rcMesh);
+        BRepAdaptor_Curve clCurve(aEdge);
+        auto project = [&](double u) {
+            Sample s;
+            gp_Pnt gpPt = clCurve.Value(u);
+            s.cCurvePt.Set((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
+            s.fParam = u;
+            if (fMaxDist > 0)
+                s.bHit = cAlg.NearestPointFromPoint(s.cCurvePt, cGrid, fMaxDist, s.ulFacet, s.cPt);
+            else
+                s.bHit = cAlg.NearestPointFromPoint(s.cCurvePt, cGrid, s.ulFacet, s.cPt);
+            return s;
+        };
+
+        std::vector<Sample> samples;
+        try {
+            GCPnts_TangentialDeflection clDefl(clCurve, clCurve.FirstParameter(), clCurve.LastParameter(),
+                                               0.1, fDeflection);
+            for (Standard_Integer i = 1; i <= clDefl.NbPoints(); i++)
+                samples.push_back(project(clDefl.Parameter(i)));
+        }
+        catch (const Standard_Failure&) {
+            return;
+        }
+
+        // bisect where the projection jumps over facets
+        std::vector<Sample> refined;
+        std::function<void(const Sample&, const Sample&, int)> refine =
+            [&](const Sample& s0, const Sample& s1, int depth) {
+            if (depth < 10 && s0.bHit && s1.bHit && !touch(s0.ulFacet, s1.ulFacet) &&
+                Base::Distance(s0.cCurvePt, s1.cCurvePt) > 0.1f*fAvgLen) {
+                Sample mid = project(0.5 * (s0.fParam + s1.fParam));
+                refine(s0, mid, depth+1);
+                refined.push_back(mid);
+                refine(mid, s1, depth+1);
+            }
+        };
+        for (std::size_t i = 0; i < samples.size(); i++) {
+            if (i > 0)
+                refine(samples[i-1], samples[i], 0);
+            refined.push_back(samples[i]);
+        }
+
+        ProjectedCurve& curve = rCurves[index];
+        for (const auto& it : refined) {
+            if (it.bHit) {
+                curve.points.push_back(it.cPt);
+                curve.facets.push_back(it.ulFacet);
+            }
+        }
+    });
+}
+
 void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                    const Base::Vector3f& dir,
                                    float tolerance,
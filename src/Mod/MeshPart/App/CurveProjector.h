@@ -174,6 +174,12 @@ public:
     {
         std::vector<Base::Vector3f> points;
     };
+    /// A curve projected onto the mesh
+    struct ProjectedCurve
+    {
+        std::vector<Base::Vector3f> points;
+        std::vector<unsigned long> facets; /**< facet index of each point */
+    };
 
     /// Construction
     MeshProjection(const MeshKernel& rMesh);
@@ -196,6 +202,14 @@ public:
      * taken if the distance between the curve point and the projected point is <= \a fMaxDist.
      */
     void projectToMesh (const TopoDS_Shape &aShape, float fMaxDist, std::vector<PolyLine>& rPolyLines) const;
+    /**
+     * Projects each point of all the curves \a aEdges onto the nearest point of the mesh. The curves are
+     * sampled with the given \a fDeflection and refined where two neighbouring points fall onto facets
+     * that don't touch. All curves share one facet grid and are projected in parallel. If \a fMaxDist > 0
+     * points farther away from the mesh are skipped.
+     */
+    void projectCurvesToMesh (const std::vector<TopoDS_Edge>& aEdges, float fDeflection, float fMaxDist,
+                              std::vector<ProjectedCurve>& rCurves) const;
     /**
      * @brief projectOnMesh
      * Projects the given points onto the mesh along a given direction. The points can can be projected
@@ -180,12 +180,115 @@ FaceUnwrapper::FaceUnwrapper(const TopoDS_Face& face)
 
 void FaceUnwrapper::findFlatNodes(int steps, double val)
 {
+    // split the mesh into its connected regions (union-find over the triangle corners)
+    long n_nodes = this->xyz_nodes.rows();
+    std::vector<long> parent(n_nodes);
+    for (long i=0; i < n_nodes; i++)
+        parent[i] = i;
+    auto find_root = [&parent](long i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (long i=0; i < this->tris.rows(); i++)
+    {
+        for (int j=1; j < 3; j++)
+        {
+            long a = find_root(this->tris(i, 0));
+            long b = find_root(this->tris(i, j));
+            if (a != b)
+                parent[b] = a;
+        }
+    }
+    std::map<long, long> region_of_root;
+    std::vector<std::vector<long>> region_tris;
+    for (long i=0; i < this->tris.rows(); i++)
+    {
+        long root = find_root(this->tris(i, 0));
+        auto it = region_of_root.insert(std::make_pair(root, static_cast<long>(region_tris.size()))).first;
+        if (it->second == static_cast<long>(region_tris.size()))
+            region_tris.emplace_back();
+        region_tris[it->second].push_back(i);
+    }
+
     std::vector<long> fixed_pins;  //TODO: INPUT
-    lscmrelax::LscmRelax mesh_flattener(this->xyz_nodes.transpose(), this->tris.transpose(), fixed_pins);
-    mesh_flattener.lscm();
-    for (int j=0; j<steps; j++)
-        mesh_flattener.relax(val);
-    this->ze_nodes = mesh_flattener.flat_vertices.transpose();
+    if (region_tris.size() < 2)
+    {
+        lscmrelax::LscmRelax mesh_flattener(this->xyz_nodes.transpose(), this->tris.transpose(), fixed_pins);
+        mesh_flattener.lscm();
+        for (int j=0; j<steps; j++)
+            mesh_flattener.relax(val);
+        this->ze_nodes = mesh_flattener.flat_vertices.transpose();
+        return;
+    }
+
+    // the regions are independent, every one is flattened with its own solver
+    long n_regions = region_tris.size();
+    std::vector<std::vector<long>> region_nodes(n_regions);
+    std::vector<ColMat<double, 2>> region_flat(n_regions);
+    auto flatten_regions = [&](long begin, long end)
+    {
+        for (long r=begin; r < end; r++)
+        {
+            std::map<long, long> local_index;
+            std::vector<long>& nodes = region_nodes[r];
+            RowMat<long, 3> tris_local(3, region_tris[r].size());
+            for (std::size_t i=0; i < region_tris[r].size(); i++)
+            {
+                for (int j=0; j < 3; j++)
+                {
+                    long node = this->tris(region_tris[r][i], j);
+                    auto it = local_index.insert(std::make_pair(node, static_cast<long>(nodes.size()))).first;
+                    if (it->second == static_cast<long>(nodes.size()))
+                        nodes.push_back(node);
+                    tris_local(j, i) = it->second;
+                }
+            }
+            RowMat<double, 3> xyz_local(3, nodes.size());
+            for (std::size_t i=0; i < nodes.size(); i++)
+                xyz_local.col(i) = this->xyz_nodes.row(nodes[i]).transpose();
+
+            lscmrelax::LscmRelax mesh_flattener(xyz_local, tris_local, std::vector<long>());
+            mesh_flattener.lscm();
+            for (int j=0; j<steps; j++)
+                mesh_flattener.relax(val);
+            region_flat[r] = mesh_flattener.flat_vertices.transpose();
+        }
+    };
+
+    // with a region for every core the regions are flattened in parallel and the
+    // loops of their solvers run serially. With fewer regions a large one would
+    // keep a single core busy, so the regions are flattened one after another
+    // and every solver runs its own loops in parallel.
+    long threads = std::max<long>(1, std::thread::hardware_concurrency());
+    if (n_regions >= threads)
+        parallel_for(n_regions, 1, flatten_regions);
+    else
+        flatten_regions(0, n_regions);
+
+    // place the flattened regions side by side along x
+    double gap = 0;
+    for (const auto& flat: region_flat)
+        gap = std::max(gap, (flat.colwise().maxCoeff() - flat.colwise().minCoeff()).maxCoeff());
+    gap *= 0.1;
+    this->ze_nodes.setZero(n_nodes, 2);
+    double x_offset = 0;
+    for (long r=0; r < n_regions; r++)
+    {
+        const ColMat<double, 2>& flat = region_flat[r];
+        Eigen::RowVector2d min_pt = flat.colwise().minCoeff();
+        Eigen::RowVector2d max_pt = flat.colwise().maxCoeff();
+        for (std::size_t i=0; i < region_nodes[r].size(); i++)
+        {
+            this->ze_nodes(region_nodes[r][i], 0) = flat(i, 0) - min_pt.x() + x_offset;
+            this->ze_nodes(region_nodes[r][i], 1) = flat(i, 1) - min_pt.y();
+        }
+        x_offset += max_pt.x() - min_pt.x() + gap;
+    }
 }
 
 ColMat<double, 3> FaceUnwrapper::interpolateFlatFace(const TopoDS_Face& face)
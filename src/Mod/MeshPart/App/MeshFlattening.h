@@ -39,6 +39,8 @@
 #include <Eigen/SparseCore>
 #include <Eigen/QR>
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 
@@ -55,6 +57,39 @@ using RowMat = Eigen::Matrix<type, size, Eigen::Dynamic>;
 typedef Eigen::Triplet<double> trip;
 typedef Eigen::SparseMatrix<double> spMat;
 
+// true in the threads that run the body of a parallel_for
+inline bool& parallel_for_nested()
+{
+    static thread_local bool nested = false;
+    return nested;
+}
+
+// call body(begin, end) for ranges of [0, size) on all cores, a range has at least min_chunk elements.
+// A parallel_for inside the body runs serially, the outer one already uses all cores.
+template <typename Func>
+void parallel_for(long size, long min_chunk, Func body)
+{
+    long threads = std::max<long>(1, std::thread::hardware_concurrency());
+    long chunk = std::max<long>(min_chunk, (size + threads - 1) / threads);
+    if (parallel_for_nested() || chunk >= size) {
+        if (size > 0)
+            body(0, size);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (long begin = chunk; begin < size; begin += chunk) {
+        workers.emplace_back([body](long b, long e) {
+            parallel_for_nested() = true;
+            body(b, e);
+        }, begin, std::min(begin + chunk, size));
+    }
+    parallel_for_nested() = true;
+    body(0, chunk);
+    parallel_for_nested() = false;
+    for (auto& worker : workers)
+        worker.join();
+}
+
 
 std::vector<ColMat<double, 3>> getBoundaries(ColMat<double, 3> vertices, ColMat<long, 3> tris);
 
@@ -145,66 +145,129 @@ LscmRelax::LscmRelax(
 //////////////////////////////////////////////////////////////////////////
 /////////////////                 F.E.M                      /////////////
 //////////////////////////////////////////////////////////////////////////
+void LscmRelax::set_relax_pattern()
+{
+    long n_vert = this->vertices.cols();
+    long n_dof = n_vert * 2 + 3;
+
+    // the entries in the order relax() adds them: every element matrix column by column,
+    // then the lagrange multipliers of every vertex
+    std::vector<std::array<long, 2>> entries;
+    entries.reserve(this->triangles.cols() * 36 + n_vert * 8);
+    for (long i=0; i<this->triangles.cols(); i++)
+    {
+        for (int col=0; col < 6; col++)
+        {
+            for (int row=0; row < 6; row++)
+                entries.push_back({{this->triangles(row / 2, i) * 2 + row % 2,
+                                    this->triangles(col / 2, i) * 2 + col % 2}});
+        }
+    }
+    for (long i=0; i < n_vert; i++)
+    {
+        entries.push_back({{i * 2, n_vert * 2}});
+        entries.push_back({{n_vert * 2, i * 2}});
+        entries.push_back({{i * 2 + 1, n_vert * 2 + 1}});
+        entries.push_back({{n_vert * 2 + 1, i * 2 + 1}});
+        entries.push_back({{i * 2, n_vert * 2 + 2}});
+        entries.push_back({{n_vert * 2 + 2, i * 2}});
+        entries.push_back({{i * 2 + 1, n_vert * 2 + 2}});
+        entries.push_back({{n_vert * 2 + 2, i * 2 + 1}});
+    }
+
+    std::vector<trip> K_g_triplets;
+    K_g_triplets.reserve(entries.size());
+    for (auto entry: entries)
+        K_g_triplets.push_back(trip(entry[0], entry[1], 1.));
+    this->K_g.resize(n_dof, n_dof);
+    this->K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
+    this->K_g.makeCompressed();
+
+    // find the position of every entry in the compressed storage
+    this->K_g_index.resize(entries.size());
+    const spMat::StorageIndex* outer = this->K_g.outerIndexPtr();
+    const spMat::StorageIndex* inner = this->K_g.innerIndexPtr();
+    parallel_for(entries.size(), 4096, [&](long begin, long end)
+    {
+        for (long i=begin; i < end; i++)
+        {
+            long row = entries[i][0];
+            long col = entries[i][1];
+            this->K_g_index[i] = std::lower_bound(inner + outer[col], inner + outer[col + 1], row) - inner;
+        }
+    });
+
+    this->relax_solver = std::make_shared<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+    this->relax_solver->analyzePattern(this->K_g);
+}
+
 void LscmRelax::relax(double weight)
 {
+    long n_vert = this->vertices.cols();
+    long n_tri = this->triangles.cols();
+    if (!this->relax_solver || this->K_g.rows() != n_vert * 2 + 3 ||
+        static_cast<long>(this->K_g_index.size()) != n_tri * 36 + n_vert * 8)
+        this->set_relax_pattern();
+
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
-    // for every triangle
-    Eigen::Matrix<double, 3, 6> B;
-    Eigen::Matrix<double, 2, 2> T;
-    Eigen::Matrix<double, 6, 6> K_m;
-    Eigen::Matrix<double, 6, 1> u_m, rhs_m;
-    Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
+    Eigen::VectorXd rhs(n_vert * 2 + 3);
     if (this->sol.size() == 0)
-        this->sol.Zero(this->vertices.cols() * 2 + 3);
-    spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
-    Vector2 v1, v2, v3, v12, v23, v31;
-    long row_pos, col_pos;
-    double A;
+        this->sol.Zero(n_vert * 2 + 3);
 
-    rhs.setZero();
+    // the element matrices don't depend on each other, so they are computed in parallel
+    Eigen::MatrixXd K_e(36, n_tri);
+    Eigen::MatrixXd rhs_e(6, n_tri);
+    parallel_for(n_tri, 1024, [&](long begin, long end)
+    {
+        Eigen::Matrix<double, 3, 6> B;
+        Eigen::Matrix<double, 2, 2> T;
+        Eigen::Matrix<double, 6, 6> K_m;
+        Eigen::Matrix<double, 6, 1> u_m;
+        Vector2 v1, v2, v3, v12, v23, v31;
+        double A;
+        for (long i=begin; i < end; i++)
+        {
+            // 1: construct B-mat in m-system
+            v1 = this->flat_vertices.col(this->triangles(0, i));
+            v2 = this->flat_vertices.col(this->triangles(1, i));
+            v3 = this->flat_vertices.col(this->triangles(2, i));
+            v12 = v2 - v1;
+            v23 = v3 - v2;
+            v31 = v1 - v3;
+            B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
+                  0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
+                 -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
+            T << v12.x(), -v12.y(),
+                 v12.y(), v12.x();
+            T /= v12.norm();
+            A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
+            B /= A * 2; // (2*area)
+
+            // 2: sigma due dqlg in m-system
+            u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
+
+            // 3: K_m = B.T * C * B
+            //    rhs_m = B.T * C * B * dqlg_m
+            K_m = B.transpose() * this->C * B * A;
+            rhs_e.col(i) = K_m * u_m;
+            Eigen::Map<Eigen::Matrix<double, 6, 6>>(K_e.col(i).data()) = K_m;
+        }
+    });
 
-    for (long i=0; i<this->triangles.cols(); i++)
+    // 5: add to rhs_g, K_g
+    double* values = this->K_g.valuePtr();
+    std::fill(values, values + this->K_g.nonZeros(), 0.);
+    rhs.setZero();
+    for (long i=0; i < n_tri; i++)
     {
-        // 1: construct B-mat in m-system
-        v1 = this->flat_vertices.col(this->triangles(0, i));
-        v2 = this->flat_vertices.col(this->triangles(1, i));
-        v3 = this->flat_vertices.col(this->triangles(2, i));
-        v12 = v2 - v1;
-        v23 = v3 - v2;
-        v31 = v1 - v3;
-        B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
-              0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
-             -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
-        T << v12.x(), -v12.y(),
-             v12.y(), v12.x();
-        T /= v12.norm();
-        A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
-        B /= A * 2; // (2*area)
-
-        // 2: sigma due dqlg in m-system
-        u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
-
-        // 3: rhs_m = B.T * C * B * dqlg_m
-        //    K_m = B.T * C * B
-        rhs_m = B.transpose() * this->C * B * u_m * A;
-        K_m = B.transpose() * this->C * B * A;
-
-        // 5: add to rhs_g, K_g
+        const long* index = &this->K_g_index[i * 36];
+        for (int j=0; j < 36; j++)
+            values[index[j]] += K_e(j, i);
         for (int j=0; j < 3; j++)
         {
-            row_pos = this->triangles(j, i);
-            rhs[row_pos * 2]     += rhs_m[j * 2];
-            rhs[row_pos * 2 + 1] += rhs_m[j * 2 +1];
-            for (int k=0; k < 3; k++)
-            {
-                col_pos = this->triangles(k, i);
-                K_g_triplets.push_back(trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2)));
-                K_g_triplets.push_back(trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2)));
-                K_g_triplets.push_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1)));
-                K_g_triplets.push_back(trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1)));
-                // we don't have to fill all because the matrix is symmetric.
-            }
+            long row_pos = this->triangles(j, i);
+            rhs[row_pos * 2]     += rhs_e(j * 2, i);
+            rhs[row_pos * 2 + 1] += rhs_e(j * 2 + 1, i);
         }
     }
     // FIXING SOME PINS:
@@ -251,19 +314,20 @@ void LscmRelax::relax(double weight)
     //     K_g_triplets.push_back(trip(i, i, 0.01));
 
     // lagrange multiplier
-    for (long i=0; i < this->flat_vertices.cols() ; i++)
+    const long* index = &this->K_g_index[n_tri * 36];
+    for (long i=0; i < n_vert; i++, index += 8)
     {
         // fixing total ux
-        K_g_triplets.push_back(trip(i * 2, this->flat_vertices.cols() * 2, 1));
-        K_g_triplets.push_back(trip(this->flat_vertices.cols() * 2, i * 2, 1));
+        values[index[0]] += 1;
+        values[index[1]] += 1;
         // fixing total uy
-        K_g_triplets.push_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 1, 1));
-        K_g_triplets.push_back(trip(this->flat_vertices.cols() * 2 + 1, i * 2 + 1, 1));
+        values[index[2]] += 1;
+        values[index[3]] += 1;
         // fixing ux*y-uy*x
-        K_g_triplets.push_back(trip(i * 2, this->flat_vertices.cols() * 2 + 2, - this->flat_vertices(1, i)));
-        K_g_triplets.push_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2, - this->flat_vertices(1, i)));
-        K_g_triplets.push_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 2, this->flat_vertices(0, i)));
-        K_g_triplets.push_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2 + 1, this->flat_vertices(0, i)));
+        values[index[4]] += - this->flat_vertices(1, i);
+        values[index[5]] += - this->flat_vertices(1, i);
+        values[index[6]] += this->flat_vertices(0, i);
+        values[index[7]] += this->flat_vertices(0, i);
     }
 
     // project out the nullspace solution:
@@ -282,13 +346,12 @@ void LscmRelax::relax(double weight)
     // rhs -= nullspace1.dot(rhs) * nullspace1;
     // rhs -= nullspace2.dot(rhs) * nullspace2;
 
-    K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
     
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    // only the numeric factorization has to be redone, the pattern is analyzed once
+    this->relax_solver->factorize(this->K_g);
+    this->sol = this->relax_solver->solve(-rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
@@ -522,18 +585,21 @@ void LscmRelax::set_q_l_m()
     // x1, y1, y2 = 0
     // -> vector<x2, x3, y3>
     this->q_l_m.resize(this->triangles.cols(), 3);
-    for (long i = 0; i < this->triangles.cols(); i++)
+    parallel_for(this->triangles.cols(), 4096, [this](long begin, long end)
     {
-        Vector2 r1 = this->flat_vertices.col(this->triangles(0, i));
-        Vector2 r2 = this->flat_vertices.col(this->triangles(1, i));
-        Vector2 r3 = this->flat_vertices.col(this->triangles(2, i));
-        Vector2 r21 = r2 - r1;
-        Vector2 r31 = r3 - r1;
-        double r21_norm = r21.norm();
-        r21.normalize();
-        // if triangle is fliped this gives wrong results!
-        this->q_l_m.row(i) << r21_norm, r31.dot(r21), -(r31.x() * r21.y() - r31.y() * r21.x());
-    }
+        for (long i = begin; i < end; i++)
+        {
+            Vector2 r1 = this->flat_vertices.col(this->triangles(0, i));
+            Vector2 r2 = this->flat_vertices.col(this->triangles(1, i));
+            Vector2 r3 = this->flat_vertices.col(this->triangles(2, i));
+            Vector2 r21 = r2 - r1;
+            Vector2 r31 = r3 - r1;
+            double r21_norm = r21.norm();
+            r21.normalize();
+            // if triangle is fliped this gives wrong results!
+            this->q_l_m.row(i) << r21_norm, r31.dot(r21), -(r31.x() * r21.y() - r31.y() * r21.x());
+        }
+    });
 }
 
 void LscmRelax::set_fixed_pins()
@@ -43,6 +43,7 @@
 
 #include <Eigen/Geometry>
 #include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
 
 typedef Eigen::SparseMatrix<double> spMat;
 
@@ -87,6 +88,13 @@ private:
     Eigen::Matrix<double, 3, 3> C;
     Eigen::VectorXd sol;
 
+    // the stiffness matrix of relax() keeps its sparsity pattern, so the pattern and
+    // the symbolic factorization are computed once and only the values are updated
+    spMat K_g;
+    std::vector<long> K_g_index;  // position in K_g.valuePtr() of every element and lagrange entry
+    std::shared_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> relax_solver;
+    void set_relax_pattern();
+
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
@@ -0,0 +1,170 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+import FreeCAD, unittest, Part, Mesh, MeshPart
+import math, multiprocessing
+
+
+#---------------------------------------------------------------------------
+# define the functions to test the FreeCAD MeshPart module
+#---------------------------------------------------------------------------
+
+
+class IncrementalMesherCases(unittest.TestCase):
+    def setUp(self):
+        self.deflection = 0.1
+
+    def checkWatertight(self, mesh):
+        self.assertFalse(mesh.hasNonManifolds())
+        # isSolid() fails on open edges
+        self.assertTrue(mesh.isSolid())
+
+    def testBox(self):
+        box = Part.makeBox(10, 20, 30)
+        # the standard mesher writes the triangulation into the shape, so give it a copy
+        standard = MeshPart.meshFromShape(Shape=box.copy(), LinearDeflection=self.deflection)
+        mesh = MeshPart.meshFromShape(Shape=box, LinearDeflection=self.deflection, Incremental=True)
+        self.checkWatertight(mesh)
+        self.assertEqual(mesh.CountPoints, standard.CountPoints)
+        self.assertEqual(mesh.CountFacets, standard.CountFacets)
+
+        again = MeshPart.meshFromShape(Shape=box, LinearDeflection=self.deflection, Incremental=True)
+        info = MeshPart.getIncrementalCacheInfo()
+        self.assertEqual(info["LastFaces"], 6)
+        self.assertEqual(info["LastMeshed"], 0)
+        self.assertEqual(again.Topology, mesh.Topology)
+
+    def testCylinder(self):
+        cylinder = Part.makeCylinder(5, 20)
+        standard = MeshPart.meshFromShape(Shape=cylinder.copy(), LinearDeflection=self.deflection)
+        mesh = MeshPart.meshFromShape(Shape=cylinder, LinearDeflection=self.deflection, Incremental=True)
+        self.checkWatertight(standard)
+        self.checkWatertight(mesh)
+
+        again = MeshPart.meshFromShape(Shape=cylinder, LinearDeflection=self.deflection, Incremental=True)
+        info = MeshPart.getIncrementalCacheInfo()
+        self.assertEqual(info["LastFaces"], len(cylinder.Faces))
+        self.assertEqual(info["LastMeshed"], 0)
+        self.assertEqual(again.CountFacets, mesh.CountFacets)
+        self.assertEqual(again.CountPoints, mesh.CountPoints)
+
+    def testChangedFace(self):
+        MeshPart.meshFromShape(Shape=Part.makeBox(10, 20, 30), LinearDeflection=self.deflection, Incremental=True)
+        # only the bottom face is the same as before
+        mesh = MeshPart.meshFromShape(Shape=Part.makeBox(10, 20, 40), LinearDeflection=self.deflection, Incremental=True)
+        info = MeshPart.getIncrementalCacheInfo()
+        self.assertEqual(info["LastMeshed"], 5)
+        self.checkWatertight(mesh)
+        self.assertLessEqual(info["MemSize"], info["MemLimit"])
+
+    def tearDown(self):
+        pass
+
+
+class FlatteningCases(unittest.TestCase):
+    def setUp(self):
+        try:
+            import numpy, flatmesh
+        except ImportError:
+            self.skipTest("flatmesh is not built")
+
+    def makePatch(self, radius, size=6):
+        # a grid on a cylinder, it can't be flattened without distortion
+        points = []
+        for i in range(size):
+            angle = 0.15 * i
+            for j in range(size):
+                points.append([radius * math.cos(angle), radius * math.sin(angle), 1.0 * j])
+        triangles = []
+        for i in range(size - 1):
+            for j in range(size - 1):
+                a = i * size + j
+                b = a + size
+                triangles += [[a, b, b + 1], [a, b + 1, a + 1]]
+        # number the points in the order the triangles use them, like the
+        # solver of a region does, so both solvers get the same input
+        order = {}
+        for t in triangles:
+            for v in t:
+                order.setdefault(v, len(order))
+        sortedPoints = [None] * len(points)
+        for v, i in order.items():
+            sortedPoints[i] = points[v]
+        return sortedPoints, [[order[v] for v in t] for t in triangles]
+
+    def flatten(self, points, triangles):
+        import numpy, flatmesh
+        flattener = flatmesh.FaceUnwrapper(numpy.array(points), numpy.array(triangles))
+        flattener.findFlatNodes(5, 0.95)
+        return numpy.array(flattener.ze_nodes)
+
+    def checkRegions(self, count):
+        # flatten several separate regions at once and compare every region
+        # with the result of flattening it alone
+        patches = [self.makePatch(5.0 + i) for i in range(count)]
+        points = []
+        triangles = []
+        for patch in patches:
+            offset = len(points)
+            points += patch[0]
+            triangles += [[v + offset for v in t] for t in patch[1]]
+        flat = self.flatten(points, triangles)
+
+        offset = 0
+        for patch in patches:
+            alone = self.flatten(*patch)
+            region = flat[offset:offset + len(patch[0])]
+            offset += len(patch[0])
+            # the regions are moved side by side
+            alone = alone - alone.min(axis=0)
+            region = region - region.min(axis=0)
+            self.assertLess(abs(region - alone).max(), 1e-6)
+
+    def testFewRegions(self):
+        self.checkRegions(2)
+
+    def testManyRegions(self):
+        # more regions than cores, so they are flattened in parallel
+        self.checkRegions(multiprocessing.cpu_count() + 1)
+
+
+class CurveProjectionCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createSphere(10.0, 50)
+        self.edges = [Part.makeCircle(10.5, FreeCAD.Vector(0, 0, z), FreeCAD.Vector(0, 0, 1))
+                      for z in (-6.0, -2.0, 0.0, 3.0, 7.0)]
+        self.edges.append(Part.makeLine(FreeCAD.Vector(-12, -12, 1), FreeCAD.Vector(12, 12, 1)))
+        # far away from the mesh, dropped with MaxDistance
+        self.edges.append(Part.makeCircle(1.0, FreeCAD.Vector(0, 0, 40)))
+
+    def project(self, edges, maxDist):
+        return MeshPart.projectCurvesOnMesh(Part.makeCompound(edges), self.mesh, MaxDistance=maxDist)
+
+    def checkBatch(self, maxDist):
+        # all curves at once must give the same as each curve alone
+        batch = self.project(self.edges, maxDist)
+        self.assertEqual(len(batch), len(self.edges))
+        for edge, (points, facets) in zip(self.edges, batch):
+            alone = self.project([edge], maxDist)
+            self.assertEqual(len(alone), 1)
+            self.assertEqual(len(points), len(alone[0][0]))
+            self.assertEqual(facets, alone[0][1])
+            for p, q in zip(points, alone[0][0]):
+                self.assertEqual(p, q)
+            for p in points:
+                self.assertLess(abs(p.Length - 10.0), 0.1)
+        return batch
+
+    def testBatchMatchesSingle(self):
+        batch = self.checkBatch(0.0)
+        for points, facets in batch:
+            self.assertTrue(len(points) > 0)
+            self.assertEqual(len(points), len(facets))
+
+    def testBatchMaxDistance(self):
+        batch = self.checkBatch(2.0)
+        for points, facets in batch[:-1]:
+            self.assertTrue(len(points) > 0)
+        self.assertEqual(len(batch[-1][0]), 0)
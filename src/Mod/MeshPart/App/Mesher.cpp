@@ -22,17 +22,36 @@
 
 #include "PreCompiled.h"
 #include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
 #include "Mesher.h"
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Part/App/TopoShape.h>
 
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepTools.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
 #include <Standard_Version.hxx>
 
 #ifdef HAVE_SMESH
@@ -154,6 +173,471 @@ const double Mesher::Vertex::deflection = gp::Resolution();
 
 // ----------------------------------------------------------------------------
 
+namespace {
+
+/// FNV-1a hash over geometry values rounded to the confusion tolerance
+class GeometryHash
+{
+public:
+    GeometryHash() : value(14695981039346656037ULL) {}
+
+    void add(uint64_t v)
+    {
+        for (int i = 0; i < 8; i++) {
+            value ^= (v >> (i * 8)) & 0xff;
+            value *= 1099511628211ULL;
+        }
+    }
+    void add(double v)
+    {
+        add(static_cast<uint64_t>(std::llround(v / Precision::Confusion())));
+    }
+    void add(const gp_Pnt& p)
+    {
+        add(p.X()); add(p.Y()); add(p.Z());
+    }
+    uint64_t getValue() const
+    {
+        return value;
+    }
+
+private:
+    uint64_t value;
+};
+
+/// The nodes of a face mesh lying on one of its edges
+struct EdgeNodes {
+    std::size_t local;              // position of the edge when exploring the face
+    std::vector<uint32_t> nodes;
+    std::vector<double> params;
+};
+
+struct FaceMesh {
+    std::vector<Base::Vector3d> points;
+    std::vector<Part::TopoShape::Facet> facets;
+    std::vector<EdgeNodes> edges;
+};
+
+/// The values a cached face mesh is looked up with
+struct FaceMeshKey {
+    uint64_t hash = 0;
+    double deflection = 0;
+    double angularDeflection = 0;
+    bool relative = false;
+    int orientation = 0;
+    double uvBounds[4] = {0, 0, 0, 0};
+    std::vector<uint64_t> edges;
+
+    // two different faces may have the same hash, so compare everything
+    bool operator == (const FaceMeshKey& other) const
+    {
+        return hash == other.hash
+            && deflection == other.deflection
+            && angularDeflection == other.angularDeflection
+            && relative == other.relative
+            && orientation == other.orientation
+            && std::equal(uvBounds, uvBounds + 4, other.uvBounds)
+            && edges == other.edges;
+    }
+};
+
+struct CachedFaceMesh {
+    FaceMeshKey key;
+    FaceMesh mesh;
+    unsigned long stamp;
+    std::size_t memSize;
+};
+
+// Meshes of single faces keyed by the hash of their geometry and mesh parameters.
+// When the meshes use more memory than the limit the least recently used ones are dropped.
+std::map<uint64_t, CachedFaceMesh> faceMeshCache;
+std::mutex faceMeshCacheMutex;
+unsigned long faceMeshCacheStamp = 0;
+std::size_t faceMeshCacheMemSize = 0;
+std::size_t faceMeshCacheLastFaces = 0;
+std::size_t faceMeshCacheLastMeshed = 0;
+const std::size_t maxFaceMeshCacheMemSize = 256 * 1024 * 1024;
+
+std::size_t getMemSize(const CachedFaceMesh& entry)
+{
+    std::size_t size = sizeof(CachedFaceMesh)
+                     + entry.key.edges.capacity() * sizeof(uint64_t)
+                     + entry.mesh.points.capacity() * sizeof(Base::Vector3d)
+                     + entry.mesh.facets.capacity() * sizeof(Part::TopoShape::Facet);
+    for (const auto& it : entry.mesh.edges) {
+        size += sizeof(EdgeNodes)
+              + it.nodes.capacity() * sizeof(uint32_t)
+              + it.params.capacity() * sizeof(double);
+    }
+    return size;
+}
+
+uint64_t edgeHash(const TopoDS_Edge& edge)
+{
+    GeometryHash hash;
+    if (BRep_Tool::Degenerated(edge)) {
+        hash.add(static_cast<uint64_t>(1));
+        hash.add(BRep_Tool::Pnt(TopExp::FirstVertex(edge)));
+        return hash.getValue();
+    }
+
+    // the adaptor ignores the orientation, so both faces of an edge get the same hash
+    BRepAdaptor_Curve curve(edge);
+    double first = curve.FirstParameter();
+    double last = curve.LastParameter();
+    hash.add(static_cast<uint64_t>(curve.GetType()));
+    hash.add(first);
+    hash.add(last);
+    for (int i = 0; i <= 4; i++)
+        hash.add(curve.Value(first + (last - first) * i / 4.0));
+    return hash.getValue();
+}
+
+FaceMeshKey faceKey(const TopoDS_Face& face, const std::vector<uint64_t>& edges,
+                    double deflection, double angularDeflection, bool relative)
+{
+    FaceMeshKey key;
+    key.deflection = deflection;
+    key.angularDeflection = angularDeflection;
+    key.relative = relative;
+    key.orientation = static_cast<int>(face.Orientation());
+    key.edges = edges;
+
+    GeometryHash hash;
+    BRepAdaptor_Surface surface(face);
+    hash.add(static_cast<uint64_t>(surface.GetType()));
+    hash.add(static_cast<uint64_t>(key.orientation));
+
+    Standard_Real u1, u2, v1, v2;
+    BRepTools::UVBounds(face, u1, u2, v1, v2);
+    key.uvBounds[0] = u1; key.uvBounds[1] = u2;
+    key.uvBounds[2] = v1; key.uvBounds[3] = v2;
+    hash.add(u1); hash.add(u2);
+    hash.add(v1); hash.add(v2);
+    for (int i = 0; i <= 2; i++) {
+        for (int j = 0; j <= 2; j++)
+            hash.add(surface.Value(u1 + (u2 - u1) * i / 2.0, v1 + (v2 - v1) * j / 2.0));
+    }
+
+    for (auto it : edges)
+        hash.add(it);
+    hash.add(deflection);
+    hash.add(angularDeflection);
+    hash.add(static_cast<uint64_t>(relative));
+    key.hash = hash.getValue();
+    return key;
+}
+
+FaceMesh meshFace(const TopoDS_Face& face, double deflection, double angularDeflection, bool relative)
+{
+    FaceMesh mesh;
+
+    // mesh a copy so that the edges shared with other faces are not written concurrently
+    BRepBuilderAPI_Copy copy(face);
+    TopoDS_Face aFace = TopoDS::Face(copy.Shape());
+    BRepMesh_IncrementalMesh aMesh(aFace, deflection, relative, angularDeflection);
+
+    TopLoc_Location loc;
+    Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(aFace, loc);
+    if (triangulation.IsNull())
+        return mesh;
+
+    const TColgp_Array1OfPnt& nodes = triangulation->Nodes();
+    mesh.points.reserve(nodes.Length());
+    for (int i = 1; i <= nodes.Length(); i++) {
+        gp_Pnt p = nodes(i).Transformed(loc.Transformation());
+        mesh.points.emplace_back(p.X(), p.Y(), p.Z());
+    }
+
+    bool flip = (aFace.Orientation() == TopAbs_REVERSED);
+    const Poly_Array1OfTriangle& triangles = triangulation->Triangles();
+    mesh.facets.reserve(triangles.Length());
+    for (int i = 1; i <= triangles.Length(); i++) {
+        Standard_Integer n1, n2, n3;
+        triangles(i).Get(n1, n2, n3);
+        Part::TopoShape::Facet tria;
+        tria.I1 = n1-1; tria.I2 = n2-1; tria.I3 = n3-1;
+        if (flip)
+            std::swap(tria.I1, tria.I2);
+        mesh.facets.push_back(tria);
+    }
+
+    std::size_t local = 0;
+    for (TopExp_Explorer xp(aFace, TopAbs_EDGE); xp.More(); xp.Next(), local++) {
+        Handle(Poly_PolygonOnTriangulation) polygon =
+            BRep_Tool::PolygonOnTriangulation(TopoDS::Edge(xp.Current()), triangulation, loc);
+        if (polygon.IsNull() || !polygon->HasParameters())
+            continue;
+
+        EdgeNodes edge;
+        edge.local = local;
+        const TColStd_Array1OfInteger& indices = polygon->Nodes();
+        const TColStd_Array1OfReal& params = polygon->Parameters()->Array1();
+        for (int i = indices.Lower(); i <= indices.Upper(); i++) {
+            edge.nodes.push_back(indices(i)-1);
+            edge.params.push_back(params(i - indices.Lower() + params.Lower()));
+        }
+        mesh.edges.push_back(edge);
+    }
+
+    return mesh;
+}
+
+/*!
+  Moves the nodes of \a mesh on its edges to the points of the merged edge parameters \a edgeParams
+  and splits the triangles at the boundary where an adjacent face has additional nodes.
+ */
+void stitchFace(FaceMesh& mesh, const std::vector<int>& faceEdges, const std::vector<TopoDS_Edge>& edges,
+                const std::vector< std::vector<double> >& edgeParams)
+{
+    typedef std::pair<uint32_t, uint32_t> Segment;
+    std::map<Segment, std::size_t> segments;
+    auto addFacet = [&](std::size_t index) {
+        const Part::TopoShape::Facet& f = mesh.facets[index];
+        segments[Segment(f.I1, f.I2)] = index;
+        segments[Segment(f.I2, f.I3)] = index;
+        segments[Segment(f.I3, f.I1)] = index;
+    };
+    for (std::size_t i = 0; i < mesh.facets.size(); i++)
+        addFacet(i);
+
+    const double tol = Precision::PConfusion();
+    for (auto& it : mesh.edges) {
+        const TopoDS_Edge& edge = edges[faceEdges[it.local]];
+        if (BRep_Tool::Degenerated(edge))
+            continue;
+
+        const std::vector<double>& params = edgeParams[faceEdges[it.local]];
+        BRepAdaptor_Curve curve(edge);
+        TopoDS_Vertex v1, v2;
+        TopExp::Vertices(edge, v1, v2);
+        auto pointAt = [&](double u) {
+            gp_Pnt p;
+            if (!v1.IsNull() && std::fabs(u - curve.FirstParameter()) <= tol)
+                p = BRep_Tool::Pnt(v1);
+            else if (!v2.IsNull() && std::fabs(u - curve.LastParameter()) <= tol)
+                p = BRep_Tool::Pnt(v2);
+            else
+                p = curve.Value(u);
+            return Base::Vector3d(p.X(), p.Y(), p.Z());
+        };
+
+        // move the own nodes onto the merged parameters
+        for (std::size_t k = 0; k < it.nodes.size(); k++) {
+            auto pos = std::lower_bound(params.begin(), params.end(), it.params[k] - tol);
+            if (pos != params.end() && std::fabs(*pos - it.params[k]) <= tol)
+                it.params[k] = *pos;
+            mesh.points[it.nodes[k]] = pointAt(it.params[k]);
+        }
+
+        // insert the nodes the other faces have between two own nodes
+        for (std::size_t k = 0; k + 1 < it.nodes.size(); k++) {
+            double ua = std::min(it.params[k], it.params[k+1]);
+            double ub = std::max(it.params[k], it.params[k+1]);
+            auto first = std::upper_bound(params.begin(), params.end(), ua + tol);
+            auto last = std::lower_bound(params.begin(), params.end(), ub - tol);
+            if (first >= last)
+                continue;
+
+            uint32_t a = it.nodes[k], b = it.nodes[k+1];
+            auto seg = segments.find(Segment(a, b));
+            if (seg == segments.end()) {
+                std::swap(a, b);
+                seg = segments.find(Segment(a, b));
+                if (seg == segments.end())
+                    continue;
+            }
+
+            // the new nodes ordered from a to b
+            std::vector<uint32_t> fan;
+            fan.push_back(a);
+            std::vector<double> between(first, last);
+            bool ascending = (a == it.nodes[k]) == (it.params[k] < it.params[k+1]);
+            if (!ascending)
+                std::reverse(between.begin(), between.end());
+            for (auto u : between) {
+                fan.push_back(static_cast<uint32_t>(mesh.points.size()));
+                mesh.points.push_back(pointAt(u));
+            }
+            fan.push_back(b);
+
+            std::size_t index = seg->second;
+            Part::TopoShape::Facet f = mesh.facets[index];
+            uint32_t c = f.I1;
+            if (f.I1 == a)
+                c = f.I3;
+            else if (f.I2 == a)
+                c = f.I1;
+            else
+                c = f.I2;
+            segments.erase(Segment(a, b));
+            segments.erase(Segment(b, c));
+            segments.erase(Segment(c, a));
+
+            for (std::size_t i = 0; i + 1 < fan.size(); i++) {
+                Part::TopoShape::Facet tria;
+                tria.I1 = fan[i]; tria.I2 = fan[i+1]; tria.I3 = c;
+                if (i == 0) {
+                    mesh.facets[index] = tria;
+                    addFacet(index);
+                }
+                else {
+                    mesh.facets.push_back(tria);
+                    addFacet(mesh.facets.size() - 1);
+                }
+            }
+        }
+    }
+}
+
+/*!
+  Meshes the faces of \a shape independently and in parallel with the standard mesher.
+  Faces whose geometry and parameters did not change since an earlier call are taken
+  from a cache. Afterwards the nodes on the shared edges are merged so that the faces
+  fit together without gaps. The domains are in the same order as TopoShape::getDomains().
+ */
+void meshFacesIncremental(const TopoDS_Shape& shape, double deflection, double angularDeflection,
+                          bool relative, std::vector<Part::TopoShape::Domain>& domains)
+{
+    std::vector<TopoDS_Face> faces;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next())
+        faces.push_back(TopoDS::Face(xp.Current()));
+
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    std::vector<TopoDS_Edge> edges;
+    edges.reserve(edgeMap.Extent());
+    for (int i = 1; i <= edgeMap.Extent(); i++)
+        edges.push_back(TopoDS::Edge(edgeMap(i)));
+
+    std::vector<int> edgeIndices(edges.size());
+    std::iota(edgeIndices.begin(), edgeIndices.end(), 0);
+    std::vector<uint64_t> edgeHashes(edges.size());
+    QtConcurrent::blockingMap(edgeIndices, [&](int i) {
+        edgeHashes[i] = edgeHash(edges[i]);
+    });
+
+    std::vector< std::vector<int> > faceEdges(faces.size());
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        for (TopExp_Explorer xp(faces[i], TopAbs_EDGE); xp.More(); xp.Next())
+            faceEdges[i].push_back(edgeMap.FindIndex(xp.Current()) - 1);
+    }
+
+    std::vector<int> faceIndices(faces.size());
+    std::iota(faceIndices.begin(), faceIndices.end(), 0);
+    std::vector<FaceMeshKey> faceKeys(faces.size());
+    QtConcurrent::blockingMap(faceIndices, [&](int i) {
+        std::vector<uint64_t> hashes;
+        for (auto it : faceEdges[i])
+            hashes.push_back(edgeHashes[it]);
+        faceKeys[i] = faceKey(faces[i], hashes, deflection, angularDeflection, relative);
+    });
+
+    std::vector<FaceMesh> meshes(faces.size());
+    std::vector<int> missing;
+    unsigned long stamp;
+    {
+        std::lock_guard<std::mutex> lock(faceMeshCacheMutex);
+        stamp = ++faceMeshCacheStamp;
+        for (std::size_t i = 0; i < faces.size(); i++) {
+            auto it = faceMeshCache.find(faceKeys[i].hash);
+            if (it != faceMeshCache.end() && it->second.key == faceKeys[i]) {
+                meshes[i] = it->second.mesh;
+                it->second.stamp = stamp;
+            }
+            else {
+                missing.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    QtConcurrent::blockingMap(missing, [&](int i) {
+        meshes[i] = meshFace(faces[i], deflection, angularDeflection, relative);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(faceMeshCacheMutex);
+        for (auto i : missing) {
+            // replaces a stale entry or one of a different face with the same hash
+            auto res = faceMeshCache.insert(std::make_pair(faceKeys[i].hash, CachedFaceMesh()));
+            CachedFaceMesh& entry = res.first->second;
+            if (!res.second)
+                faceMeshCacheMemSize -= entry.memSize;
+            entry.key = faceKeys[i];
+            entry.mesh = meshes[i];
+            entry.stamp = stamp;
+            entry.memSize = getMemSize(entry);
+            faceMeshCacheMemSize += entry.memSize;
+        }
+
+        if (faceMeshCacheMemSize > maxFaceMeshCacheMemSize) {
+            // drop the least recently used faces first and the ones of this call last
+            std::vector<std::map<uint64_t, CachedFaceMesh>::iterator> entries;
+            entries.reserve(faceMeshCache.size());
+            for (auto it = faceMeshCache.begin(); it != faceMeshCache.end(); ++it)
+                entries.push_back(it);
+            std::stable_sort(entries.begin(), entries.end(), [](const std::map<uint64_t, CachedFaceMesh>::iterator& a,
+                                                                const std::map<uint64_t, CachedFaceMesh>::iterator& b) {
+                return a->second.stamp < b->second.stamp;
+            });
+            for (auto it : entries) {
+                if (faceMeshCacheMemSize <= maxFaceMeshCacheMemSize)
+                    break;
+                faceMeshCacheMemSize -= it->second.memSize;
+                faceMeshCache.erase(it);
+            }
+        }
+
+        faceMeshCacheLastFaces = faces.size();
+        faceMeshCacheLastMeshed = missing.size();
+    }
+
+    Base::Console().Log("Mesher: %d of %d faces meshed, the others taken from the cache\n",
+                        static_cast<int>(missing.size()), static_cast<int>(faces.size()));
+
+    // merge the parameters of the nodes of all faces on each edge
+    std::vector< std::vector<double> > edgeParams(edges.size());
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        for (const auto& it : meshes[i].edges) {
+            std::vector<double>& params = edgeParams[faceEdges[i][it.local]];
+            params.insert(params.end(), it.params.begin(), it.params.end());
+        }
+    }
+    QtConcurrent::blockingMap(edgeParams, [](std::vector<double>& params) {
+        const double tol = Precision::PConfusion();
+        std::sort(params.begin(), params.end());
+        params.erase(std::unique(params.begin(), params.end(), [tol](double a, double b) {
+            return b - a <= tol;
+        }), params.end());
+    });
+
+    QtConcurrent::blockingMap(faceIndices, [&](int i) {
+        stitchFace(meshes[i], faceEdges[i], edges, edgeParams);
+    });
+
+    domains.resize(faces.size());
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        domains[i].points.swap(meshes[i].points);
+        domains[i].facets.swap(meshes[i].facets);
+    }
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+Mesher::IncrementalCacheInfo Mesher::getIncrementalCacheInfo()
+{
+    std::lock_guard<std::mutex> lock(faceMeshCacheMutex);
+    IncrementalCacheInfo info;
+    info.entries = faceMeshCache.size();
+    info.memSize = faceMeshCacheMemSize;
+    info.memLimit = maxFaceMeshCacheMemSize;
+    info.lastFaces = faceMeshCacheLastFaces;
+    info.lastMeshed = faceMeshCacheLastMeshed;
+    return info;
+}
+
 Mesher::Mesher(const TopoDS_Shape& s)
   : shape(s)
   , method(None)
@@ -167,6 +651,7 @@ Mesher::Mesher(const TopoDS_Shape& s)
   , relative(false)
   , regular(false)
   , segments(false)
+  , incremental(false)
 #if defined (HAVE_NETGEN)
   , fineness(5)
   , growthRate(0)
@@ -187,13 +672,18 @@ Mesh::MeshObject* Mesher::createMesh() const
 {
     // OCC standard mesher
     if (method == Standard) {
-        if (!shape.IsNull()) {
-            BRepTools::Clean(shape);
-            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        std::vector<Part::TopoShape::Domain> domains;
+        if (incremental) {
+            meshFacesIncremental(shape, deflection, angularDeflection, relative, domains);
         }
+        else {
+            if (!shape.IsNull()) {
+                BRepTools::Clean(shape);
+                BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+            }
 
-        std::vector<Part::TopoShape::Domain> domains;
-        Part::TopoShape(shape).getDomains(domains);
+            Part::TopoShape(shape).getDomains(domains);
+        }
 
         std::map<uint32_t, std::vector<std::size_t> > colorMap;
         for (std::size_t i=0; i<colors.size(); i++) {
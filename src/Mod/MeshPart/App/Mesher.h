@@ -95,6 +95,11 @@ public:
     { return segments; }
     void setColors(const std::vector<uint32_t>& c)
     { colors = c; }
+    /// Mesh the faces independently with the standard mesher and reuse the meshes of unchanged faces
+    void setIncremental(bool s)
+    { incremental = s; }
+    bool isIncremental() const
+    { return incremental; }
     //@}
 
 #if defined (HAVE_NETGEN)
@@ -133,6 +138,20 @@ public:
 
     Mesh::MeshObject* createMesh() const;
 
+    /// Statistics of the face mesh cache used by the incremental mode
+    struct IncrementalCacheInfo {
+        std::size_t entries = 0;
+        /// Estimated memory used by the cached face meshes in bytes
+        std::size_t memSize = 0;
+        /// Memory budget in bytes
+        std::size_t memLimit = 0;
+        /// Number of faces of the shape of the last incremental call
+        std::size_t lastFaces = 0;
+        /// Number of faces meshed by the last incremental call, the others came from the cache
+        std::size_t lastMeshed = 0;
+    };
+    static IncrementalCacheInfo getIncrementalCacheInfo();
+
 private:
     const TopoDS_Shape& shape;
     Method method;
@@ -145,6 +164,7 @@ private:
     bool relative;
     bool regular;
     bool segments;
+    bool incremental;
 #if defined (HAVE_NETGEN)
     int fineness;
     double growthRate;
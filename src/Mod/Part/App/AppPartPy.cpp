@@ -462,6 +462,13 @@ public:
         add_varargs_method("clearShapeCache",&Module::clearShapeCache,
             "clearShapeCache() -- Clears internal shape cache"
         );
+        add_varargs_method("getShapeCacheInfo",&Module::getShapeCacheInfo,
+            "getShapeCacheInfo() -- Returns a dict with the statistics of the internal shape cache\n\n"
+            "* Entries: number of cached shapes\n"
+            "* MemSize: estimated memory used by the cached shapes in bytes\n"
+            "* MemLimit: memory budget in bytes (parameter ShapeCacheSize), 0 if unlimited\n"
+            "* Hits, Misses, Evictions: counters since the start"
+        );
         add_keyword_method("getShape",&Module::getShape,
             "getShape(obj,subname=None,mat=None,needSubElement=False,transform=True,retType=0):\n"
             "Obtain the the TopoShape of a given object with SubName reference\n\n"
@@ -2178,6 +2185,20 @@ private:
         return Py::Object();
     }
 
+    Py::Object getShapeCacheInfo(const Py::Tuple &args) {
+        if (!PyArg_ParseTuple(args.ptr(),""))
+            throw Py::Exception();
+        Part::Feature::ShapeCacheInfo info = Part::Feature::getShapeCacheInfo();
+        Py::Dict dict;
+        dict.setItem("Entries", Py::Long(static_cast<unsigned long>(info.entries)));
+        dict.setItem("MemSize", Py::Long(static_cast<unsigned long>(info.memSize)));
+        dict.setItem("MemLimit", Py::Long(static_cast<unsigned long>(info.memLimit)));
+        dict.setItem("Hits", Py::Long(info.hits));
+        dict.setItem("Misses", Py::Long(info.misses));
+        dict.setItem("Evictions", Py::Long(info.evictions));
+        return dict;
+    }
+
     Py::Object splitSubname(const Py::Tuple& args) {
         const char *subname;
         if (!PyArg_ParseTuple(args.ptr(), "s",&subname))
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <sstream>
+# include <list>
 # include <gp_Trsf.hxx>
 # include <gp_Ax1.hxx>
 # include <BRepBuilderAPI_MakeShape.hxx>
@@ -212,26 +213,78 @@ TopoDS_Shape Feature::getShape(const App::DocumentObject *obj, const char *subna
     return getTopoShape(obj,subname,needSubElement,pmat,powner,resolveLink,transform,true).getShape();
 }
 
-struct ShapeCache {
+struct ShapeCache : public ParameterGrp::ObserverType {
 
-    std::unordered_map<const App::Document*,
-        std::map<std::pair<const App::DocumentObject*, std::string> ,TopoShape> > cache;
+    typedef std::pair<const App::DocumentObject*, std::string> Key;
+    typedef std::list<std::pair<const App::Document*, Key> > LRUList;
+
+    struct Entry {
+        TopoShape shape;
+        const void *tshape = 0;
+        LRUList::iterator iter;
+    };
+
+    std::unordered_map<const App::Document*, std::map<Key, Entry> > cache;
+
+    // Most recently used entry at the front
+    LRUList lru;
+
+    // Memory accounting per TopoDS_TShape, so that entries sharing the same
+    // underlying shape (e.g. the same shape with different locations) are
+    // only counted once.
+    std::unordered_map<const void*, std::pair<int, std::size_t> > shapeSizes;
+
+    Feature::ShapeCacheInfo info;
+
+    ParameterGrp::handle hGrp;
 
     bool inited = false;
+
+    ~ShapeCache() {
+        // ParameterGrp asserts that all its observers are detached when destroyed
+        if(hGrp)
+            hGrp->Detach(this);
+    }
+
     void init() {
         if(inited)
             return;
         inited = true;
+        hGrp = App::GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Mod/Part/General");
+        hGrp->Attach(this);
+        updateLimit();
         App::GetApplication().signalDeleteDocument.connect(
                 boost::bind(&ShapeCache::slotDeleteDocument, this, bp::_1));
         App::GetApplication().signalDeletedObject.connect(
                 boost::bind(&ShapeCache::slotClear, this, bp::_1));
         App::GetApplication().signalChangedObject.connect(
                 boost::bind(&ShapeCache::slotChanged, this, bp::_1,bp::_2));
+        // signalChangedObject may be deferred by App::ChangeBatch, so clear
+        // the cache before the change as well.
+        App::GetApplication().signalBeforeChangeObject.connect(
+                boost::bind(&ShapeCache::slotChanged, this, bp::_1,bp::_2));
+    }
+
+    void OnChange(Base::Subject<const char*> &, const char* sReason) {
+        if(sReason && strcmp(sReason,"ShapeCacheSize")==0) {
+            updateLimit();
+            evict();
+        }
+    }
+
+    void updateLimit() {
+        long limit = hGrp->GetInt("ShapeCacheSize", 512);
+        info.memLimit = limit>0 ? static_cast<std::size_t>(limit)*1024*1024 : 0;
     }
 
     void slotDeleteDocument(const App::Document &doc) {
-        cache.erase(&doc);
+        auto it = cache.find(&doc);
+        if(it == cache.end())
+            return;
+        for(auto &v : it->second)
+            release(v.second);
+        cache.erase(it);
     }
 
     void slotChanged(const App::DocumentObject &obj, const App::Property &prop) {
@@ -252,32 +305,134 @@ struct ShapeCache {
         for(auto it2=map.lower_bound(std::make_pair(&obj,std::string()));
                 it2!=map.end() && it2->first.first==&obj;)
         {
+            release(it2->second);
             it2 = map.erase(it2);
         }
     }
 
+    void clear() {
+        cache.clear();
+        lru.clear();
+        shapeSizes.clear();
+        info.entries = 0;
+        info.memSize = 0;
+    }
+
+    void release(Entry &entry) {
+        lru.erase(entry.iter);
+        --info.entries;
+        auto it = shapeSizes.find(entry.tshape);
+        if(it == shapeSizes.end())
+            return;
+        if(--it->second.first == 0) {
+            info.memSize -= it->second.second;
+            shapeSizes.erase(it);
+        }
+    }
+
     bool getShape(const App::DocumentObject *obj, TopoShape &shape, const char *subname=0) {
         init();
-        auto &entry = cache[obj->getDocument()];
-        if(!subname) subname = "";
-        auto it = entry.find(std::make_pair(obj,std::string(subname)));
-        if(it!=entry.end()) {
-            shape = it->second;
-            return !shape.isNull();
+        auto it = cache.find(obj->getDocument());
+        if(it != cache.end()) {
+            if(!subname) subname = "";
+            auto it2 = it->second.find(std::make_pair(obj,std::string(subname)));
+            if(it2!=it->second.end()) {
+                lru.splice(lru.begin(), lru, it2->second.iter);
+                shape = it2->second.shape;
+                if(!shape.isNull()) {
+                    ++info.hits;
+                    return true;
+                }
+            }
         }
+        ++info.misses;
         return false;
     }
 
     void setShape(const App::DocumentObject *obj, const TopoShape &shape, const char *subname=0) {
         init();
         if(!subname) subname = "";
-        cache[obj->getDocument()][std::make_pair(obj,std::string(subname))] = shape;
+        auto doc = obj->getDocument();
+        auto key = std::make_pair(obj,std::string(subname));
+        auto &map = cache[doc];
+        auto it = map.find(key);
+        if(it != map.end()) {
+            release(it->second);
+            map.erase(it);
+        }
+
+        auto &entry = map[key];
+        entry.shape = shape;
+        lru.emplace_front(doc, key);
+        entry.iter = lru.begin();
+        ++info.entries;
+        if(!shape.isNull()) {
+            entry.tshape = shape.getShape().TShape().operator->();
+            auto &size = shapeSizes[entry.tshape];
+            if(size.first++ == 0) {
+                size.second = shape.getMemSize();
+                info.memSize += size.second;
+            }
+        }
+        evict();
+    }
+
+    // Apply the transformation to the shape, and reuse the result if the same
+    // shape has already been transformed with the same matrix. Only non-uniform
+    // scaling transformations are cached, because they require copying the
+    // geometry. Others are neither looked up nor counted as a miss.
+    bool transformShape(const App::DocumentObject *owner, TopoShape &shape,
+            const Base::Matrix4D &mat) 
+    {
+        if(mat.hasScale() >= 0)
+            return shape.transformShape(mat,false,true);
+
+        std::ostringstream ss;
+        ss << "\x01Transform";
+        for(int i=0; i<4; ++i) {
+            for(int j=0; j<4; ++j)
+                ss << ',' << std::hexfloat << mat[i][j];
+        }
+        std::string key = ss.str();
+        if(getShape(owner, shape, key.c_str()))
+            return true;
+        if(!shape.transformShape(mat,false,true))
+            return false;
+        setShape(owner, shape, key.c_str());
+        return true;
+    }
+
+    void evict() {
+        if(!info.memLimit)
+            return;
+        // Always keep the most recently added entry
+        while(info.memSize > info.memLimit && lru.size() > 1) {
+            auto item = lru.back();
+            auto it = cache.find(item.first);
+            if(it == cache.end()) {
+                lru.pop_back();
+                continue;
+            }
+            auto it2 = it->second.find(item.second);
+            if(it2 == it->second.end()) {
+                lru.pop_back();
+                continue;
+            }
+            release(it2->second);
+            it->second.erase(it2);
+            ++info.evictions;
+        }
     }
 };
 static ShapeCache _ShapeCache;
 
 void Feature::clearShapeCache() {
-    _ShapeCache.cache.clear();
+    _ShapeCache.clear();
+}
+
+Feature::ShapeCacheInfo Feature::getShapeCacheInfo() {
+    _ShapeCache.init();
+    return _ShapeCache.info;
 }
 
 static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subname, 
@@ -363,7 +518,7 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
     bool scaled = false;
     if(obj!=owner) {
         if(_ShapeCache.getShape(owner,shape)) {
-            auto scaled = shape.transformShape(mat,false,true);
+            auto scaled = _ShapeCache.transformShape(owner,shape,mat);
             if(owner->getDocument()!=obj->getDocument()) {
                 // shape.reTagElementMap(obj->getID(),obj->getDocument()->getStringHasher());
                 _ShapeCache.setShape(obj,shape,subname);
@@ -391,9 +546,9 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
         if(shape.isNull())
             return shape;
         if(owner==obj)
-            shape.transformShape(mat*linkMat,false,true);
+            _ShapeCache.transformShape(linked,shape,mat*linkMat);
         else
-            shape.transformShape(linkMat,false,true);
+            _ShapeCache.transformShape(linked,shape,linkMat);
         // shape.reTagElementMap(tag,hasher);
 
     } else {
@@ -472,7 +627,7 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
     _ShapeCache.setShape(owner,shape);
 
     if(owner!=obj) {
-        scaled = shape.transformShape(mat,false,true);
+        scaled = _ShapeCache.transformShape(owner,shape,mat);
         if(owner->getDocument()!=obj->getDocument()) {
             // shape.reTagElementMap(obj->getID(),obj->getDocument()->getStringHasher());
             _ShapeCache.setShape(obj,shape,subname);
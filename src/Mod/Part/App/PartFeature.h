@@ -102,6 +102,19 @@ public:
 
     static void clearShapeCache();
 
+    /// Statistics of the shape cache used by getTopoShape()
+    struct ShapeCacheInfo {
+        std::size_t entries = 0;
+        /// Estimated memory used by the cached shapes in bytes
+        std::size_t memSize = 0;
+        /// Memory budget in bytes, 0 if unlimited
+        std::size_t memLimit = 0;
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+        unsigned long evictions = 0;
+    };
+    static ShapeCacheInfo getShapeCacheInfo();
+
     static App::DocumentObject *getShapeOwner(const App::DocumentObject *obj, const char *subname=0);
 
     static bool hasShapeOwner(const App::DocumentObject *obj, const char *subname=0) {
@@ -43,10 +43,6 @@
 # include <gp_GTrsf.hxx>
 # include <gp_Trsf.hxx>
 
-#if OCC_VERSION_HEX >= 0x060800
-# include <OSD_OpenFile.hxx>
-#endif
-
 #endif // _PreComp_
 
 #include <Base/Console.h>
@@ -215,6 +211,15 @@ App::Property *PropertyPartShape::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyPartShape::CopyOnChange(void) const
+{
+    // The property never modifies the referenced shape in place but always
+    // replaces it, so the undo record can safely share the shape data.
+    PropertyPartShape *prop = new PropertyPartShape();
+    prop->_Shape = this->_Shape;
+    return prop;
+}
+
 void PropertyPartShape::Paste(const App::Property &from)
 {
     aboutToSetValue();
@@ -269,7 +274,7 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     }
 }
 
-// The following two functions are copied from OCCT BRepTools.cxx and modified
+// The following function is copied from OCCT BRepTools.cxx and modified
 // to disable saving of triangulation
 //
 static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S) {
@@ -280,39 +285,6 @@ static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S) {
   SS.Write(Sh,S);
 }
 
-static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
-{
-  std::ofstream os;
-#if OCC_VERSION_HEX >= 0x060800
-  OSD_OpenStream(os, File, std::ios::out);
-#else
-  os.open(File, std::ios::out);
-#endif
-  if (!os.rdbuf()->is_open()) return Standard_False;
-
-  Standard_Boolean isGood = (os.good() && !os.eof());
-  if(!isGood)
-    return isGood;
-
-  BRepTools_ShapeSet SS(Standard_False);
-  // SS.SetProgress(PR);
-  SS.Add(Sh);
-
-  os << "DBRep_DrawableShape\n";  // for easy Draw read
-  SS.Write(os);
-  isGood = os.good();
-  if(isGood )
-    SS.Write(Sh,os);
-  os.flush();
-  isGood = os.good();
-
-  errno = 0;
-  os.close();
-  isGood = os.good() && isGood && !errno;
-
-  return isGood;
-}
-
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
     // If the shape is empty we simply store nothing. The file size will be 0 which
@@ -329,52 +301,29 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
         bool direct = App::GetApplication().GetParameterGroupByPath
             ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
         if (!direct) {
-            // create a temporary file and copy the content to the zip stream
-            // once the tmp. filename is known use always the same because otherwise
-            // we may run into some problems on the Linux platform
-            static Base::FileInfo fi(App::Application::getTempFileName());
-
-            if (!BRepTools_Write(myShape,(Standard_CString)fi.filePath().c_str())) {
-                // Note: Do NOT throw an exception here because if the tmp. file could
-                // not be created we should not abort.
+            // write the shape to a memory buffer first and copy it to the zip stream
+            std::stringstream str(std::ios::in | std::ios::out | std::ios::binary);
+            BRepTools_Write(myShape, str);
+            if (!str.good()) {
+                // Note: Do NOT throw an exception here because if the buffer could
+                // not be written we should not abort.
                 // We only print an error message but continue writing the next files to the
                 // stream...
                 App::PropertyContainer* father = this->getContainer();
                 if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
                     App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-                    Base::Console().Error("Shape of '%s' cannot be written to BRep file '%s'\n",
-                        obj->Label.getValue(),fi.filePath().c_str());
+                    Base::Console().Error("Shape of '%s' cannot be written to BRep\n",
+                        obj->Label.getValue());
                 }
                 else {
-                    Base::Console().Error("Cannot save BRep file '%s'\n", fi.filePath().c_str());
+                    Base::Console().Error("Cannot save BRep\n");
                 }
 
-                std::stringstream ss;
-                ss << "Cannot save BRep file '" << fi.filePath() << "'";
-                writer.addError(ss.str());
+                writer.addError("Cannot save BRep");
             }
-
-            Base::ifstream file(fi, std::ios::in | std::ios::binary);
-            if (file) {
-                //unsigned long ulSize = 0;
-                std::streambuf* buf = file.rdbuf();
-                //if (buf) {
-                //    unsigned long ulCurr;
-                //    ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-                //    ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-                //    buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-                //}
-
-                // read in the ASCII file and write back to the stream
-                //std::strstreambuf sbuf(ulSize);
-                //file >> &sbuf;
-                //writer.Stream() << &sbuf;
-                writer.Stream() << buf;
+            else {
+                writer.Stream() << str.rdbuf();
             }
-
-            file.close();
-            // remove temp file
-            fi.deleteFile();
         }
         else {
             BRepTools_Write(myShape, writer.Stream());
@@ -395,26 +344,26 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
             ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
         if (!direct) {
             BRep_Builder builder;
-            // create a temporary file and copy the content from the zip stream
-            Base::FileInfo fi(App::Application::getTempFileName());
-
-            // read in the ASCII file and write back to the file stream
-            Base::ofstream file(fi, std::ios::out | std::ios::binary);
-            unsigned long ulSize = 0;
-            if (reader) {
-                std::streambuf* buf = file.rdbuf();
-                reader >> buf;
-                file.flush();
-                ulSize = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-            }
-            file.close();
+            // copy the content from the zip stream into a memory buffer
+            std::stringstream str(std::ios::in | std::ios::out | std::ios::binary);
+            if (reader)
+                str << reader.rdbuf();
 
-            // Read the shape from the temp file, if the file is empty the stored shape was already empty.
-            // If it's still empty after reading the (non-empty) file there must occurred an error.
+            // Read the shape from the buffer, if it is empty the stored shape was already empty.
+            // If it's still empty after reading the (non-empty) buffer there must occurred an error.
             TopoDS_Shape shape;
+            str.seekg(0, std::ios::end);
+            std::streamoff ulSize = str.tellg();
+            str.seekg(0, std::ios::beg);
             if (ulSize > 0) {
-                if (!BRepTools::Read(shape, (Standard_CString)fi.filePath().c_str(), builder)) {
-                    // Note: Do NOT throw an exception here because if the tmp. created file could
+                try {
+                    BRepTools::Read(shape, str, builder);
+                }
+                catch (Standard_Failure&) {
+                }
+
+                if (shape.IsNull()) {
+                    // Note: Do NOT throw an exception here because if the buffer could
                     // not be read it's NOT an indication for an invalid input stream 'reader'.
                     // We only print an error message but continue reading the next files from the
                     // stream...
@@ -422,16 +371,14 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
                     if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
                         App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
                         Base::Console().Error("BRep file '%s' with shape of '%s' seems to be empty\n",
-                            fi.filePath().c_str(),obj->Label.getValue());
+                            reader.getFileName().c_str(),obj->Label.getValue());
                     }
                     else {
-                        Base::Console().Warning("Loaded BRep file '%s' seems to be empty\n", fi.filePath().c_str());
+                        Base::Console().Warning("Loaded BRep file '%s' seems to be empty\n", reader.getFileName().c_str());
                     }
                 }
             }
 
-            // delete the temp file
-            fi.deleteFile();
             setValue(shape);
         }
         else {
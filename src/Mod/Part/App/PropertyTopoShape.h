@@ -84,6 +84,8 @@ public:
     void RestoreDocFile(Base::Reader &reader);
 
     App::Property *Copy(void) const;
+    /// Shares the shape with the undo record instead of copying it
+    App::Property *CopyOnChange(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
     //@}
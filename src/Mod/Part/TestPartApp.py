@@ -52,6 +52,34 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testShapeCache(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        part = self.Doc.addObject("App::Part","Part")
+        part.addObject(box)
+        self.Doc.recompute()
+        Part.clearShapeCache()
+
+        # the compound of the group is cached
+        Part.getShape(part)
+        info = Part.getShapeCacheInfo()
+        self.assertGreater(info["Entries"], 0)
+        Part.getShape(part)
+        self.assertGreater(Part.getShapeCacheInfo()["Hits"], info["Hits"])
+
+        # only the lookup by sub-object name misses, moving the cached shape
+        # of the box is not a cacheable transformation
+        Part.getShape(part, "Box.")
+        info = Part.getShapeCacheInfo()
+        Part.getShape(part, "Box.")
+        self.assertEqual(Part.getShapeCacheInfo()["Misses"], info["Misses"] + 1)
+
+        # the memory budget follows the parameter
+        grp = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+        size = grp.GetInt("ShapeCacheSize", 512)
+        grp.SetInt("ShapeCacheSize", 100)
+        self.assertEqual(Part.getShapeCacheInfo()["MemLimit"], 100*1024*1024)
+        grp.SetInt("ShapeCacheSize", size)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -31,6 +31,7 @@
 # include <TopExp_Explorer.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Face.hxx>
+# include <map>
 # include <sstream>
 #endif
 
@@ -41,6 +42,8 @@
 #include <App/ComplexGeoData.h>
 #include <boost/regex.hpp>
 
+#include <QtConcurrentMap>
+
 
 #include "PovTools.h"
 #include "LuxTools.h"
@@ -70,70 +73,142 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    PovTools::meshShape(Shape, fMeshDeviation);
+    ShapeMesh shapeMesh = PovTools::getShapeMesh(Shape);
+    std::size_t count = shapeMesh.faceMeshes.size();
+
+    // a mesh placed by several faces is written once as an object and
+    // instanced, the other faces are merged into one mesh
+    std::vector<int> uses(shapeMesh.meshes.size(), 0);
+    for (int m : shapeMesh.faceMeshes)
+        uses[m]++;
+    std::vector<int> objects;
+    for (std::size_t m=0; m < uses.size(); m++) {
+        if (uses[m] > 1)
+            objects.push_back(m);
+    }
+
+    // index of the first vertex of each merged face in the mesh
+    std::vector<std::size_t> faces;
+    std::vector<long> offsets;
+    long vi = 0;
+    for (std::size_t l=0; l < count; l++) {
+        if (uses[shapeMesh.faceMeshes[l]] == 1) {
+            faces.push_back(l);
+            offsets.push_back(vi);
+            vi += shapeMesh.meshes[shapeMesh.faceMeshes[l]].vertices.size();
+        }
+    }
+
+    // gather vertices, normals and face indices of the merged faces and then
+    // of the objects, formatting them in parallel
+    std::size_t numChunks = faces.size() + objects.size();
+    std::vector<std::string> triindices(numChunks);
+    std::vector<std::string> N(numChunks);
+    std::vector<std::string> P(numChunks);
+    std::vector<int> jobs(numChunks);
+    for (std::size_t i=0; i < numChunks; i++)
+        jobs[i] = i;
+    QtConcurrent::blockingMap(jobs, [&](int i) {
+        gp_Trsf trsf;
+        long offset = 0;
+        int m;
+        if (i < static_cast<int>(faces.size())) {
+            m = shapeMesh.faceMeshes[faces[i]];
+            trsf = shapeMesh.facePlacements[faces[i]];
+            offset = offsets[i];
+        }
+        else {
+            m = objects[i - faces.size()];
+        }
+        const FaceMesh& mesh = shapeMesh.meshes[m];
+        std::stringstream t, n, p;
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-    
-    // write object
-    out << "AttributeBegin #  \"" << PartName << "\"" << endl;
-    out << "Transform [1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1]" << endl;
-    out << "NamedMaterial \"FreeCADMaterial_" << PartName << "\"" << endl;
-    out << "Shape \"mesh\"" << endl;
-    
-    // gather vertices, normals and face indices
-    std::stringstream triindices;
-    std::stringstream N;
-    std::stringstream P;
-    l = 1;
-    int vi = 0;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        PovTools::transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
         // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
+        for (const gp_Vec& v : mesh.vertices) {
+            gp_Pnt vertex(v.XYZ());
+            vertex.Transform(trsf);
+            p << vertex.X() << " " << vertex.Y() << " " << vertex.Z() << " ";
         }
 
         // writing per vertex normals
-        for (int j=0; j < nbNodesInFace; j++) {
-            N << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
+        for (const gp_Vec& v : mesh.normals) {
+            gp_Vec normal(v);
+            normal.Transform(trsf);
+            n << normal.X() << " "  << normal.Y() << " " << normal.Z() << " ";
         }
 
         // writing triangle indices
-        for (int k=0; k < nbTriInFace; k++) {
-            triindices << cons[3*k]+vi << " " << cons[3*k+2]+vi << " " << cons[3*k+1]+vi << " ";
+        for (std::size_t k=0; k+2 < mesh.indices.size(); k+=3) {
+            t << mesh.indices[k]+offset << " " << mesh.indices[k+2]+offset << " " << mesh.indices[k+1]+offset << " ";
         }
-        
-        vi = vi + nbNodesInFace;
-        
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
 
-        seq.next();
+        triindices[i] = t.str();
+        N[i] = n.str();
+        P[i] = p.str();
+    });
+
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", numChunks + 1);
+
+    // writes the chunks [first, last) as one mesh
+    auto writeMesh = [&](std::size_t first, std::size_t last, const std::string& name) {
+        out << "Shape \"mesh\"" << endl;
+        out << "    \"integer triindices\" [";
+        for (std::size_t i=first; i < last; i++) {
+            out << triindices[i];
+            seq.next();
+        }
+        out << "]" << endl;
+        out << "    \"point P\" [";
+        for (std::size_t i=first; i < last; i++)
+            out << P[i];
+        out << "]" << endl;
+        out << "    \"normal N\" [";
+        for (std::size_t i=first; i < last; i++)
+            out << N[i];
+        out << "]" << endl;
+        out << "    \"bool generatetangents\" [\"false\"]" << endl;
+        out << "    \"string name\" [\"" << name << "\"]" << endl;
+    };
 
-    } // end of face loop
+    // write object
+    out << "AttributeBegin #  \"" << PartName << "\"" << endl;
+    out << "Transform [1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1]" << endl;
+    out << "NamedMaterial \"FreeCADMaterial_" << PartName << "\"" << endl;
 
     // write mesh data
-    out << "    \"integer triindices\" [" << triindices.str() << "]" << endl;
-    out << "    \"point P\" [" << P.str() << "]" << endl;
-    out << "    \"normal N\" [" << N.str() << "]" << endl;
-    out << "    \"bool generatetangents\" [\"false\"]" << endl;
-    out << "    \"string name\" [\"" << PartName << "\"]" << endl;
+    if (!faces.empty())
+        writeMesh(0, faces.size(), PartName);
+
+    // define the objects, the names must be unique in the scene
+    std::map<int, std::string> objectNames;
+    for (std::size_t i=0; i < objects.size(); i++) {
+        std::stringstream name;
+        name << PartName << "_" << objects[i];
+        objectNames[objects[i]] = name.str();
+        out << "ObjectBegin \"" << name.str() << "\"" << endl;
+        writeMesh(faces.size() + i, faces.size() + i + 1, name.str());
+        out << "ObjectEnd" << endl;
+    }
+
+    // place the instances, Lux expects the matrix column by column
+    for (std::size_t l=0; l < count; l++) {
+        int m = shapeMesh.faceMeshes[l];
+        if (uses[m] == 1)
+            continue;
+        const gp_Trsf& trsf = shapeMesh.facePlacements[l];
+        const gp_XYZ& tr = trsf.TranslationPart();
+        out << "AttributeBegin" << endl;
+        out << "ConcatTransform [";
+        for (int c=1; c <= 3; c++) {
+            for (int r=1; r <= 3; r++)
+                out << trsf.Value(r, c) << " ";
+            out << "0 ";
+        }
+        out << tr.X() << " " << tr.Y() << " " << tr.Z() << " 1]" << endl;
+        out << "ObjectInstance \"" << objectNames[m] << "\"" << endl;
+        out << "AttributeEnd" << endl;
+    }
     out << "AttributeEnd # \"\"" << endl;
 }
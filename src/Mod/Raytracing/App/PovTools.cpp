@@ -34,6 +34,11 @@
 # include <sstream>
 #endif
 
+#include <algorithm>
+#include <map>
+
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
@@ -225,79 +230,80 @@ void PovTools::writeShape(std::ostream &out, const char *PartName,
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
-
-
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-
-    // write the file
-    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
+    meshShape(Shape, fMeshDeviation);
+    ShapeMesh shapeMesh = getShapeMesh(Shape);
+
+    // format the meshes in parallel, faces sharing a mesh refer to its declaration
+    std::vector<std::string> blocks(shapeMesh.meshes.size());
+    std::vector<int> jobs(blocks.size());
+    for (std::size_t i=0; i < jobs.size(); i++)
+        jobs[i] = i;
+    QtConcurrent::blockingMap(jobs, [&](int i) {
+        const FaceMesh& mesh = shapeMesh.meshes[i];
+        int l = i + 1;
+        std::stringstream str;
         // writing per face header
-        out << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
+        str << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
         << "#declare " << PartName << l << " = mesh2{" << endl
         << "  vertex_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
+        << "    " << mesh.vertices.size() << "," << endl;
         // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            out << "    <" << vertices[i].X() << ","
-            << vertices[i].Z() << ","
-            << vertices[i].Y() << ">,"
+        for (const gp_Vec& v : mesh.vertices) {
+            str << "    <" << v.X() << ","
+            << v.Z() << ","
+            << v.Y() << ">,"
             << endl;
         }
-        out << "  }" << endl
+        str << "  }" << endl
         // writing per vertex normals
         << "  normal_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        for (int j=0; j < nbNodesInFace; j++) {
-            out << "    <" << vertexnormals[j].X() << ","
-            << vertexnormals[j].Z() << ","
-            << vertexnormals[j].Y() << ">,"
+        << "    " << mesh.normals.size() << "," << endl;
+        for (const gp_Vec& n : mesh.normals) {
+            str << "    <" << n.X() << ","
+            << n.Z() << ","
+            << n.Y() << ">,"
             << endl;
         }
 
-        out << "  }" << endl
+        str << "  }" << endl
         // writing triangle indices
         << "  face_indices {" << endl
-        << "    " << nbTriInFace << "," << endl;
-        for (int k=0; k < nbTriInFace; k++) {
-            out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
+        << "    " << mesh.indices.size() / 3 << "," << endl;
+        for (std::size_t k=0; k+2 < mesh.indices.size(); k+=3) {
+            str << "    <" << mesh.indices[k] << ","<< mesh.indices[k+2] << ","<< mesh.indices[k+1] << ">," << endl;
         }
         // end of face
-        out << "  }" << endl
+        str << "  }" << endl
         << "} // end of Face"<< l << endl << endl;
+        blocks[i] = str.str();
+    });
 
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
+    Base::SequencerLauncher seq("Writing file", blocks.size() + 1);
 
+    // write the file
+    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
+    for (const std::string& block : blocks) {
+        out << block;
         seq.next();
-
-    } // end of face loop
-
+    }
 
     out << endl << endl << "// Declare all together +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
     << "#declare " << PartName << " = union {" << endl;
-    for (int i=1; i < l; i++) {
-        out << "mesh2{ " << PartName << i << "}" << endl;
+    for (std::size_t i=0; i < shapeMesh.faceMeshes.size(); i++) {
+        out << "mesh2{ " << PartName << shapeMesh.faceMeshes[i] + 1;
+        const gp_Trsf& trsf = shapeMesh.facePlacements[i];
+        if (trsf.Form() != gp_Identity) {
+            // the matrix swaps y and z like the vertices above
+            const int axis[3] = {1, 3, 2};
+            out << " matrix <";
+            for (int r=0; r < 3; r++) {
+                for (int c=0; c < 3; c++)
+                    out << trsf.Value(axis[c], axis[r]) << ",";
+            }
+            const gp_XYZ& t = trsf.TranslationPart();
+            out << t.X() << "," << t.Z() << "," << t.Y() << ">";
+        }
+        out << "}" << endl;
     }
     out << "}" << endl;
 }
@@ -311,49 +317,35 @@ void PovTools::writeShapeCSV(const char *FileName,
 
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    meshShape(Shape, fMeshDeviation);
+    ShapeMesh shapeMesh = getShapeMesh(Shape);
 
     // open the file and write
     std::ofstream fout(FileName);
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", shapeMesh.faceMeshes.size() + 1);
 
     // write the file
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
+    for (std::size_t l=0; l < shapeMesh.faceMeshes.size(); l++) {
+        const FaceMesh& mesh = shapeMesh.meshes[shapeMesh.faceMeshes[l]];
+        const gp_Trsf& trsf = shapeMesh.facePlacements[l];
 
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing per face header
         // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            fout << vertices[i].X() << cSeperator
-            << vertices[i].Z() << cSeperator
-            << vertices[i].Y() << cSeperator
-            << vertexnormals[i].X() * fLength <<cSeperator
-            << vertexnormals[i].Z() * fLength <<cSeperator
-            << vertexnormals[i].Y() * fLength <<cSeperator
+        for (std::size_t i=0; i < mesh.vertices.size(); i++) {
+            gp_Pnt vertex(mesh.vertices[i].XYZ());
+            gp_Vec normal(mesh.normals[i]);
+            vertex.Transform(trsf);
+            normal.Transform(trsf);
+            fout << vertex.X() << cSeperator
+            << vertex.Z() << cSeperator
+            << vertex.Y() << cSeperator
+            << normal.X() * fLength <<cSeperator
+            << normal.Z() * fLength <<cSeperator
+            << normal.Y() * fLength <<cSeperator
             << endl;
         }
 
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
         seq.next();
 
     } // end of face loop
@@ -361,22 +353,104 @@ void PovTools::writeShapeCSV(const char *FileName,
     fout.close();
 }
 
-void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace )
+void PovTools::meshShape(const TopoDS_Shape& Shape, float fMeshDeviation)
 {
+    // reuse the triangulation of the shape if it is fine enough, e.g. the
+    // one made for the 3D view
+    bool meshed = true;
     TopLoc_Location aLoc;
+    for (TopExp_Explorer ex(Shape, TopAbs_FACE); ex.More() && meshed; ex.Next()) {
+        Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(TopoDS::Face(ex.Current()), aLoc);
+        meshed = !aPoly.IsNull() && aPoly->Deflection() <= fMeshDeviation;
+    }
 
-    // doing the meshing and checking the result
-    //BRepMesh_IncrementalMesh MESH(aFace,fDeflection);
-    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
-    if (aPoly.IsNull()) {
+    if (!meshed) {
+        BRepMesh_IncrementalMesh MESH(Shape, fMeshDeviation, Standard_False, 0.5, Standard_True);
+    }
+}
+
+ShapeMesh PovTools::getShapeMesh(const TopoDS_Shape& Shape)
+{
+    // collect the distinct faces, a face placed several times is meshed once
+    std::vector<TopoDS_Face> faces;
+    std::vector<int> faceMeshes;
+    std::vector<gp_Trsf> facePlacements;
+    std::map<std::pair<const void*, int>, int> faceIndex;
+    for (TopExp_Explorer ex(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
+        std::pair<const void*, int> key(aFace.TShape().operator->(), aFace.Orientation());
+        auto it = faceIndex.insert(std::make_pair(key, static_cast<int>(faces.size())));
+        if (it.second)
+            faces.push_back(TopoDS::Face(aFace.Located(TopLoc_Location())));
+        faceMeshes.push_back(it.first->second);
+        facePlacements.push_back(aFace.Location().Transformation());
+    }
+
+    std::vector<FaceMesh> meshes(faces.size());
+    std::vector<int> valid(faces.size());
+    std::vector<int> jobs(faces.size());
+    for (std::size_t i=0; i < jobs.size(); i++)
+        jobs[i] = i;
+    QtConcurrent::blockingMap(jobs, [&](int i) {
+        valid[i] = transferToMesh(faces[i], meshes[i]);
+    });
+
+    // skip the faces without triangulation
+    ShapeMesh result;
+    std::vector<int> meshIndex(faces.size(), -1);
+    for (std::size_t i=0; i < faces.size(); i++) {
+        if (valid[i]) {
+            meshIndex[i] = result.meshes.size();
+            result.meshes.push_back(std::move(meshes[i]));
+        }
+        else {
+            Base::Console().Log("Empty face triangulation\n");
+        }
+    }
+    for (std::size_t i=0; i < faceMeshes.size(); i++) {
+        int index = meshIndex[faceMeshes[i]];
+        if (index >= 0) {
+            result.faceMeshes.push_back(index);
+            result.facePlacements.push_back(facePlacements[i]);
+        }
+    }
+
+    return result;
+}
+
+void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace )
+{
+    FaceMesh mesh;
+    if (!transferToMesh(aFace, mesh)) {
         Base::Console().Log("Empty face triangulation\n");
         nbNodesInFace =0;
         nbTriInFace = 0;
-        vertices = 0l;
-        cons = 0l;
+        *vertices = 0l;
+        *cons = 0l;
         return;
     }
 
+    nbNodesInFace = mesh.vertices.size();
+    nbTriInFace = mesh.indices.size() / 3;
+    *vertices = new gp_Vec[nbNodesInFace];
+    *vertexnormals = new gp_Vec[nbNodesInFace];
+    std::copy(mesh.vertices.begin(), mesh.vertices.end(), *vertices);
+    std::copy(mesh.normals.begin(), mesh.normals.end(), *vertexnormals);
+
+    *cons = new long[3*(nbTriInFace)+1];
+    std::copy(mesh.indices.begin(), mesh.indices.end(), *cons);
+}
+
+bool PovTools::transferToMesh(const TopoDS_Face& aFace, FaceMesh& mesh)
+{
+    TopLoc_Location aLoc;
+
+    // doing the meshing and checking the result
+    //BRepMesh_IncrementalMesh MESH(aFace,fDeflection);
+    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
+    if (aPoly.IsNull())
+        return false;
+
     // getting the transformation of the shape/face
     gp_Trsf myTransf;
     Standard_Boolean identity = true;
@@ -387,15 +461,13 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
 
     Standard_Integer i;
     // getting size and create the array
-    nbNodesInFace = aPoly->NbNodes();
-    nbTriInFace = aPoly->NbTriangles();
-    *vertices = new gp_Vec[nbNodesInFace];
-    *vertexnormals = new gp_Vec[nbNodesInFace];
-    for (i=0; i < nbNodesInFace; i++) {
-        (*vertexnormals)[i]= gp_Vec(0.0,0.0,0.0);
-    }
-
-    *cons = new long[3*(nbTriInFace)+1];
+    Standard_Integer nbNodesInFace = aPoly->NbNodes();
+    Standard_Integer nbTriInFace = aPoly->NbTriangles();
+    mesh.vertices.assign(nbNodesInFace, gp_Vec());
+    mesh.normals.assign(nbNodesInFace, gp_Vec(0.0,0.0,0.0));
+    mesh.indices.resize(3*nbTriInFace);
+    std::vector<gp_Vec>& vertices = mesh.vertices;
+    std::vector<gp_Vec>& vertexnormals = mesh.normals;
 
     // check orientation
     TopAbs_Orientation orient = aFace.Orientation();
@@ -434,27 +506,27 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         //Standard_Real Area = 0.5 * Normal.Magnitude();
 
         // add the triangle normal to the vertex normal for all points of this triangle
-        (*vertexnormals)[N1-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N2-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N3-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-
-        (*vertices)[N1-1].SetX((float)(V1.X()));
-        (*vertices)[N1-1].SetY((float)(V1.Y()));
-        (*vertices)[N1-1].SetZ((float)(V1.Z()));
-        (*vertices)[N2-1].SetX((float)(V2.X()));
-        (*vertices)[N2-1].SetY((float)(V2.Y()));
-        (*vertices)[N2-1].SetZ((float)(V2.Z()));
-        (*vertices)[N3-1].SetX((float)(V3.X()));
-        (*vertices)[N3-1].SetY((float)(V3.Y()));
-        (*vertices)[N3-1].SetZ((float)(V3.Z()));
+        vertexnormals[N1-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+        vertexnormals[N2-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+        vertexnormals[N3-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
+
+        vertices[N1-1].SetX((float)(V1.X()));
+        vertices[N1-1].SetY((float)(V1.Y()));
+        vertices[N1-1].SetZ((float)(V1.Z()));
+        vertices[N2-1].SetX((float)(V2.X()));
+        vertices[N2-1].SetY((float)(V2.Y()));
+        vertices[N2-1].SetZ((float)(V2.Z()));
+        vertices[N3-1].SetX((float)(V3.X()));
+        vertices[N3-1].SetY((float)(V3.Y()));
+        vertices[N3-1].SetZ((float)(V3.Z()));
 
         int j = i - 1;
         N1--;
         N2--;
         N3--;
-        (*cons)[3*j] = N1;
-        (*cons)[3*j+1] = N2;
-        (*cons)[3*j+2] = N3;
+        mesh.indices[3*j] = N1;
+        mesh.indices[3*j+1] = N2;
+        mesh.indices[3*j+2] = N3;
     }
 
     // normalize all vertex normals
@@ -465,8 +537,8 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         try {
             Handle(Geom_Surface) Surface = BRep_Tool::Surface(aFace);
 
-            gp_Pnt vertex((*vertices)[i].XYZ());
-//     gp_Pnt vertex((*vertices)[i][0], (*vertices)[i][1], (*vertices)[i][2]);
+            gp_Pnt vertex(vertices[i].XYZ());
+//     gp_Pnt vertex(vertices[i][0], vertices[i][1], vertices[i][2]);
             GeomAPI_ProjectPointOnSurf ProPntSrf(vertex, Surface);
             Standard_Real fU, fV;
             ProPntSrf.Parameters(1, fU, fV);
@@ -475,15 +547,17 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
 
             clNormal = clPropOfFace.Normal();
             gp_Vec temp = clNormal;
-            //Base::Console().Log("unterschied:%.2f",temp.dot((*vertexnormals)[i]));
-            if ( temp * (*vertexnormals)[i] < 0 )
+            //Base::Console().Log("unterschied:%.2f",temp.dot(vertexnormals[i]));
+            if ( temp * vertexnormals[i] < 0 )
                 temp = -temp;
-            (*vertexnormals)[i] = temp;
+            vertexnormals[i] = temp;
 
         }
         catch (...) {
         }
 
-        (*vertexnormals)[i].Normalize();
+        vertexnormals[i].Normalize();
     }
+
+    return true;
 }
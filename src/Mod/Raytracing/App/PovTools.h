@@ -24,7 +24,9 @@
 #ifndef _PovTools_h_
 #define _PovTools_h_
 
+#include <gp_Trsf.hxx>
 #include <gp_Vec.hxx>
+#include <string>
 #include <vector>
 
 class TopoDS_Shape;
@@ -71,6 +73,27 @@ public:
 };
 
 
+/// triangulation of a face with per vertex normals
+struct FaceMesh
+{
+    std::vector<gp_Vec> vertices;
+    std::vector<gp_Vec> normals;
+    /// three vertex indices per triangle, counting from 0
+    std::vector<long> indices;
+};
+
+/// triangulations of all faces of a shape. Faces which only differ in
+/// their placement (e.g. the copies of a linked object) share one mesh.
+struct ShapeMesh
+{
+    /// the distinct meshes, in the coordinates of the unplaced face
+    std::vector<FaceMesh> meshes;
+    /// index into meshes for each face of the shape
+    std::vector<int> faceMeshes;
+    /// placement of each face of the shape
+    std::vector<gp_Trsf> facePlacements;
+};
+
 class AppRaytracingExport PovTools
 {
 public:
@@ -113,6 +136,15 @@ public:
 
 
     static void transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace );
+
+    /// get the triangulation of a face, returns false if the face has none
+    static bool transferToMesh(const TopoDS_Face& aFace, FaceMesh& mesh);
+
+    /// tessellate the shape unless all its faces are already meshed finely enough
+    static void meshShape(const TopoDS_Shape& Shape, float fMeshDeviation);
+
+    /// get the triangulations of all faces of a meshed shape, shared faces only once
+    static ShapeMesh getShapeMesh(const TopoDS_Shape& Shape);
 };
 
 
@@ -0,0 +1,46 @@
+# Unit tests for the Raytracing module
+# LGPL
+
+import FreeCAD, unittest, Part, Raytracing, re
+
+
+def countTriangles(pov):
+    # each mesh2 declaration starts its index list with the count
+    return sum(int(n) for n in re.findall(r"face_indices \{\s*(\d+),", pov))
+
+
+class ShapeMeshCases(unittest.TestCase):
+    def setUp(self):
+        # copies of a box that only differ in their placement share the faces
+        box = Part.makeBox(2, 3, 4)
+        copies = [box.translated(FreeCAD.Vector(10 * i, 0, 0)) for i in range(4)]
+        self.compound = Part.makeCompound(copies)
+
+    def testPovrayDeclaresSharedFacesOnce(self):
+        pov = Raytracing.getPartAsPovray("Boxes", self.compound)
+        self.assertEqual(len(re.findall(r"#declare Boxes\d+ = mesh2", pov)), 6)
+        self.assertEqual(len(re.findall(r"mesh2\{ Boxes\d+", pov)), 24)
+
+    def testLuxInstancesSharedFaces(self):
+        lux = Raytracing.getPartAsLux("Boxes", self.compound)
+        self.assertEqual(lux.count("ObjectBegin"), 6)
+        self.assertEqual(lux.count("ObjectInstance"), 24)
+        self.assertEqual(lux.count('Shape "mesh"'), 6)
+
+    def testLuxMergesSingleFaces(self):
+        lux = Raytracing.getPartAsLux("Box", Part.makeBox(2, 3, 4))
+        self.assertEqual(lux.count("ObjectBegin"), 0)
+        self.assertEqual(lux.count('Shape "mesh"'), 1)
+
+    def testFineTriangulationReused(self):
+        # the export deviation is 0.1, a finer triangulation is kept
+        sphere = Part.makeSphere(10)
+        triangles = len(sphere.tessellate(0.01)[1])
+        pov = Raytracing.getPartAsPovray("Sphere", sphere)
+        self.assertEqual(countTriangles(pov), triangles)
+
+    def testCoarseTriangulationReplaced(self):
+        sphere = Part.makeSphere(10)
+        triangles = len(sphere.tessellate(1.0)[1])
+        pov = Raytracing.getPartAsPovray("Sphere", sphere)
+        self.assertGreater(countTriangles(pov), triangles)
@@ -22,15 +22,17 @@
 
 
 #include "PreCompiled.h"
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 
+#include <cfloat>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 #include <boost_bind_bind.hpp>
+#include <math.hxx>
+#include <math_Vector.hxx>
 
 #include <Mod/Mesh/App/Core/Approximation.h>
 #include <Base/Sequencer.h>
@@ -768,14 +770,10 @@ BSplineParameterCorrection::BSplineParameterCorrection(unsigned usUOrder, unsign
   : ParameterCorrection(usUOrder, usVOrder, usUCtrlpoints, usVCtrlpoints)
   , _clUSpline(usUCtrlpoints+usUOrder)
   , _clVSpline(usVCtrlpoints+usVOrder)
-  , _clSmoothMatrix(0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clFirstMatrix (0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clSecondMatrix(0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
-  , _clThirdMatrix (0,usUCtrlpoints*usVCtrlpoints-1,
-                    0,usUCtrlpoints*usVCtrlpoints-1)
+  , _clSmoothRows(0, usUCtrlpoints*usVCtrlpoints)
+  , _clFirstRows (0, usUCtrlpoints*usVCtrlpoints)
+  , _clSecondRows(0, usUCtrlpoints*usVCtrlpoints)
+  , _clThirdRows (0, usUCtrlpoints*usVCtrlpoints)
 {
     Init();
 }
@@ -785,10 +783,11 @@ void BSplineParameterCorrection::Init()
     // Initialisierungen
     _pvcUVParam       = NULL;
     _pvcPoints        = NULL;
-    _clFirstMatrix.Init(0.0);
-    _clSecondMatrix.Init(0.0);
-    _clThirdMatrix.Init(0.0);
-    _clSmoothMatrix.Init(0.0);
+    int dim = _usUCtrlpoints*_usVCtrlpoints;
+    _clFirstRows.resize(0, dim);
+    _clSecondRows.resize(0, dim);
+    _clThirdRows.resize(0, dim);
+    _clSmoothRows.resize(0, dim);
 
     /* Berechne die Knotenvektoren */
     unsigned usUMax = _usUCtrlpoints-_usUOrder+1;
@@ -858,32 +857,65 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
     _clVSpline.SetKnots(_vVKnots, _vVMults, _usVOrder);
 }
 
-void BSplineParameterCorrection::DoParameterCorrection(int iIter)
+namespace Reen {
+/**
+ * Splits the index range [lower, upper] into blocks that are processed in parallel.
+ */
+static std::vector< std::pair<int, int> > MakeBlocks(int lower, int upper)
 {
-    int i=0;
-    double fMaxDiff=0.0, fMaxScalar=1.0;
-    double fWeight = _fSmoothInfluence;
+    int count = upper - lower + 1;
+    int blocks = std::max<int>(1, std::min<int>(count / 1024, 4 * QThread::idealThreadCount()));
+    std::vector< std::pair<int, int> > ranges;
+    for (int i=0; i<blocks; i++) {
+        int begin = lower + static_cast<int>(static_cast<long long>(count) * i / blocks);
+        int end = lower + static_cast<int>(static_cast<long long>(count) * (i + 1) / blocks);
+        ranges.push_back(std::make_pair(begin, end));
+    }
+    return ranges;
+}
 
-    Base::SequencerLauncher seq("Calc surface...", iIter*_pvcPoints->Length());
+struct ProjectionResult
+{
+    double fMaxDiff;
+    double fMaxScalar;
+    double fError;
+};
 
-    do {
-        fMaxScalar = 1.0;
-        fMaxDiff   = 0.0;
+/**
+ * Corrects the u/v parameters of a block of points by a Newton step towards the
+ * foot point on the surface.
+ */
+class ParameterProjection
+{
+public:
+    ParameterProjection(const Handle(Geom_BSplineSurface)& surf,
+                        const TColgp_Array1OfPnt& points,
+                        TColgp_Array1OfPnt2d& params)
+      : surf(surf), points(points), params(params)
+    {
+    }
+    ProjectionResult project(const std::pair<int, int>& range) const
+    {
+        ProjectionResult result;
+        result.fMaxDiff = 0.0;
+        result.fMaxScalar = 1.0;
+        result.fError = 0.0;
 
-        Handle(Geom_BSplineSurface) pclBSplineSurf = new Geom_BSplineSurface(_vCtrlPntsOfSurf,
-                                                    _vUKnots, _vVKnots, _vUMults, _vVMults, _usUOrder-1, _usVOrder-1);
+        // each block evaluates its own copy because older OCC versions cache in the surface
+        Handle(Geom_BSplineSurface) pclBSplineSurf = Handle(Geom_BSplineSurface)::DownCast(surf->Copy());
 
-        for (int ii=_pvcPoints->Lower();ii <=_pvcPoints->Upper();ii++) {
+        for (int ii=range.first; ii<range.second; ii++) {
             double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
+            const gp_Pnt& pnt = points(ii);
             gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
             gp_Pnt PntX;
             gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
             //Berechne die ersten beiden Ableitungen und Punkt an der Stelle (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+            gp_Pnt2d& uvValue = params(ii);
             pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
             gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
             gp_Vec ErrorVec = X - P;
+            result.fError += ErrorVec.SquareMagnitude();
 
             // Berechne Xu x Xv die Normale in X(u,v)
             gp_Dir clNormal = Xu ^ Xv;
@@ -891,8 +923,8 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
             //Pruefe, ob X = P
             if (!(X.IsEqual(P,0.001,0.001))) {
                 ErrorVec.Normalize();
-                if (fabs(clNormal*ErrorVec) < fMaxScalar)
-                    fMaxScalar = fabs(clNormal*ErrorVec);
+                if (fabs(clNormal*ErrorVec) < result.fMaxScalar)
+                    result.fMaxScalar = fabs(clNormal*ErrorVec);
             }
 
             fDeltaU =  ( (P-X) * Xu ) / ( (P-X)*Xuu - Xu*Xu );
@@ -909,335 +941,350 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
                 fV <= 1.0 && fV >= 0.0) {
                 uvValue.SetX(fU);
                 uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                result.fMaxDiff = std::max<double>(fabs(fDeltaU), result.fMaxDiff);
+                result.fMaxDiff = std::max<double>(fabs(fDeltaV), result.fMaxDiff);
             }
-
-            seq.next();
         }
 
-        if (_bSmoothing) {
-            fWeight *= 0.5f;
-            SolveWithSmoothing(fWeight);
-        }
-        else {
-            SolveWithoutSmoothing();
-        }
-
-        i++;
+        return result;
     }
-    while(i<iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
-}
 
-bool BSplineParameterCorrection::SolveWithoutSmoothing()
-{
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Matrix Xx (0, ulDim-1, 0, 0);
-    math_Matrix Xy (0, ulDim-1, 0, 0);
-    math_Matrix Xz (0, ulDim-1, 0, 0);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
+private:
+    Handle(Geom_BSplineSurface) surf;
+    const TColgp_Array1OfPnt& points;
+    TColgp_Array1OfPnt2d& params;
+};
 
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+/**
+ * Sets up and solves the over-determined system of the least-squares fit. A point
+ * only has uOrder*vOrder non-zero basis functions, so every row of the system is
+ * sparse. The rows are set up block-wise in parallel and solved together with the
+ * rows of the smoothing terms by a sparse QR decomposition, which unlike the normal
+ * equations does not square the condition number of the system.
+ */
+class LeastSquaresSystem
+{
+public:
+    typedef std::vector< Eigen::Triplet<double> > Triplets;
+
+    LeastSquaresSystem(BSplineBasis& uSpline, BSplineBasis& vSpline,
+                       int uOrder, int vOrder, int uCtrl, int vCtrl,
+                       const TColgp_Array1OfPnt& points,
+                       const TColgp_Array1OfPnt2d& params)
+      : uSpline(uSpline), vSpline(vSpline)
+      , uOrder(uOrder), vOrder(vOrder), uCtrl(uCtrl), vCtrl(vCtrl)
+      , points(points), params(params)
+    {
+    }
+    Triplets assemble(const std::pair<int, int>& range) const
+    {
+        Triplets triplets;
+        triplets.reserve((range.second-range.first)*uOrder*vOrder);
+
+        TColStd_Array1OfReal basisU(0, uOrder-1);
+        TColStd_Array1OfReal basisV(0, vOrder-1);
+        for (int ii=range.first; ii<range.second; ii++) {
+            const gp_Pnt2d& uvValue = params(ii);
+            // ausserhalb des Definitionsbereichs verschwinden alle Basis-Funktionen
+            if (!(uvValue.X() >= 0.0 && uvValue.X() <= 1.0 &&
+                  uvValue.Y() >= 0.0 && uvValue.Y() <= 1.0))
+                continue;
+
+            // Index der ersten nicht verschwindenden Basis-Funktion
+            int firstU = uSpline.FindSpan(uvValue.X()) - (uOrder-1);
+            int firstV = vSpline.FindSpan(uvValue.Y()) - (vOrder-1);
+            uSpline.AllBasisFunctions(uvValue.X(), basisU);
+            vSpline.AllBasisFunctions(uvValue.Y(), basisV);
+
+            int row = ii - points.Lower();
+            for (int j=0; j<uOrder; j++) {
+                for (int k=0; k<vOrder; k++) {
+                    double value = basisU(j) * basisV(k);
+                    if (value != 0.0)
+                        triplets.push_back(Eigen::Triplet<double>(row, (firstU+j)*vCtrl + firstV+k, value));
                 }
             }
         }
-    }
 
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
+        return triplets;
     }
+    static void append(Triplets& sum, const Triplets& triplets)
+    {
+        sum.insert(sum.end(), triplets.begin(), triplets.end());
+    }
+    bool solve(const Eigen::SparseMatrix<double>* smooth, double fWeight, TColgp_Array2OfPnt& poles) const
+    {
+        std::vector< std::pair<int, int> > ranges = MakeBlocks(points.Lower(), points.Upper());
+        Triplets triplets = QtConcurrent::blockingMappedReduced<Triplets>
+            (ranges, boost::bind(&LeastSquaresSystem::assemble, this, bp::_1),
+             &LeastSquaresSystem::append, QtConcurrent::UnorderedReduce);
+        if (triplets.empty())
+            return false;
 
-    // Loese das ueberbest. LGS mit der Householder-Transformation
-    math_Householder hhX(M,bx);
-    math_Householder hhY(M,by);
-    math_Householder hhZ(M,bz);
+        // die Zeilen der Glaettungsterme werden mit der Wurzel des Gewichts angehaengt
+        int dim = uCtrl*vCtrl;
+        int rows = points.Length();
+        if (smooth && fWeight > 0.0) {
+            double fScale = sqrt(fWeight);
+            for (int k=0; k<smooth->outerSize(); k++) {
+                for (Eigen::SparseMatrix<double>::InnerIterator it(*smooth, k); it; ++it)
+                    triplets.push_back(Eigen::Triplet<double>(rows + it.row(), it.col(), fScale * it.value()));
+            }
+            rows += smooth->rows();
+        }
 
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone()))
-        //LGS konnte nicht geloest werden
-        return false;
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
+        Eigen::SparseMatrix<double> A(rows, dim);
+        A.setFromTriplets(triplets.begin(), triplets.end());
+        A.makeCompressed();
+        Eigen::SparseQR< Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver(A);
+        if (solver.info() != Eigen::Success)
+            return false;
+        //LGS ist singulaer, wenn Kontrollpunkte keinen Einfluss auf die Punkte haben
+        if (solver.rank() < dim)
+            return false;
 
-    unsigned ulIdx=0;
-    for (unsigned j=0;j<_usUCtrlpoints;j++) {
-        for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx,0),Xy(ulIdx,0),Xz(ulIdx,0));
-            ulIdx++;
+        Eigen::MatrixXd b = Eigen::MatrixXd::Zero(rows, 3);
+        for (int ii=points.Lower(); ii<=points.Upper(); ii++) {
+            const gp_Pnt& pnt = points(ii);
+            b.row(ii - points.Lower()) << pnt.X(), pnt.Y(), pnt.Z();
         }
-    }
-
-    return true;
-}
+        Eigen::MatrixXd x = solver.solve(b);
+        if (solver.info() != Eigen::Success)
+            return false;
 
-namespace Reen {
-class ScalarProduct
-{
-public:
-    ScalarProduct(const math_Matrix& mat) : mat(mat)
-    {
-    }
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n=mat.LowerCol(); n<=mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
+        for (int j=0; j<uCtrl; j++) {
+            for (int k=0; k<vCtrl; k++) {
+                int row = j*vCtrl + k;
+                poles(j,k) = gp_Pnt(x(row,0), x(row,1), x(row,2));
+            }
         }
-        return out;
+
+        return true;
     }
 
 private:
-    const math_Matrix& mat;
+    BSplineBasis& uSpline;
+    BSplineBasis& vSpline;
+    int uOrder, vOrder;
+    int uCtrl, vCtrl;
+    const TColgp_Array1OfPnt& points;
+    const TColgp_Array1OfPnt2d& params;
 };
-}
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+/**
+ * A smoothing functional is the integral of a sum of squares of linear combinations
+ * of the partial derivatives of the surface. Each square is a polynomial of degree
+ * 2*(order-1) on a knot span, so a Gauss formula with order points per span integrates
+ * it exactly. Every Gauss point and square then gives one sparse row, and the matrix
+ * of the functional is rows^T * rows.
+ */
+typedef double (*SmoothTerm)(const double* du, const double* dv);
+
+static void CalcSmoothRows(BSplineBasis& uSpline, BSplineBasis& vSpline,
+                           const TColStd_Array1OfReal& uKnots, const TColStd_Array1OfReal& vKnots,
+                           int uOrder, int vOrder, int vCtrl,
+                           const std::vector<SmoothTerm>& terms,
+                           Base::SequencerLauncher& seq,
+                           Eigen::SparseMatrix<double>& rows)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Vector Xx (0, ulDim-1);
-    math_Vector Xy (0, ulDim-1);
-    math_Vector Xz (0, ulDim-1);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-    math_Vector Mbx(0, ulDim-1);
-    math_Vector Mby(0, ulDim-1);
-    math_Vector Mbz(0, ulDim-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
-
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
+    struct GaussPoint
+    {
+        double fWeight;
+        int first;
+        std::vector<double> der; // bis zur 3. Ableitung der nicht verschwindenden Basis-Funktionen
+    };
+
+    auto gaussPoints = [](BSplineBasis& spline, const TColStd_Array1OfReal& knots, int order) {
+        math_Vector roots(1, order), weights(1, order);
+        math::GaussPoints(order, roots);
+        math::GaussWeights(order, weights);
+
+        std::vector<GaussPoint> gauss;
+        TColStd_Array1OfReal der(0, 3);
+        for (int i=knots.Lower(); i<knots.Upper(); i++) {
+            double fMin = knots(i);
+            double fMax = knots(i+1);
+            for (int j=1; j<=order; j++) {
+                double fParam = 0.5*(roots(j)+1.0)*(fMax-fMin)+fMin;
+                GaussPoint gp;
+                gp.fWeight = 0.5*(fMax-fMin)*weights(j);
+                gp.first = spline.FindSpan(fParam) - (order-1);
+                gp.der.resize(4*order);
+                for (int k=0; k<order; k++) {
+                    spline.DerivativesOfBasisFunction(gp.first+k, 3, fParam, der);
+                    for (int d=0; d<4; d++)
+                        gp.der[4*k+d] = der(d);
                 }
+                gauss.push_back(gp);
             }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+        }
+        return gauss;
+    };
+
+    std::vector<GaussPoint> uGauss = gaussPoints(uSpline, uKnots, uOrder);
+    std::vector<GaussPoint> vGauss = gaussPoints(vSpline, vKnots, vOrder);
+
+    std::vector< Eigen::Triplet<double> > triplets;
+    int row = 0;
+    for (const auto& gu : uGauss) {
+        for (const auto& gv : vGauss) {
+            double fScale = sqrt(gu.fWeight * gv.fWeight);
+            for (auto term : terms) {
+                for (int j=0; j<uOrder; j++) {
+                    for (int k=0; k<vOrder; k++) {
+                        double value = term(&gu.der[4*j], &gv.der[4*k]);
+                        if (value != 0.0)
+                            triplets.push_back(Eigen::Triplet<double>(row, (gu.first+j)*vCtrl + gv.first+k,
+                                                                      fScale * value));
+                    }
                 }
+                row++;
             }
         }
+        seq.next();
     }
 
-    //Das Produkt aus ihrer Transformierten und ihr selbst ergibt die quadratische Systemmatrix (langsam)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    for (unsigned m=0; m<ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n=m; n<ulDim; n++) {
-            MTM(m,n) = MTM(n,m) = Mm * M.Col(n);
-        }
-    }
-#else // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    QFuture< std::vector<double> > future = QtConcurrent::mapped
-        (columns, boost::bind(&ScalarProduct::multiply, &scalar, bp::_1));
-    QFutureWatcher< std::vector<double> > watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    int rowIndex=0;
-    for (QFuture< std::vector<double> >::const_iterator it = future.begin(); it != future.end(); ++it) {
-        int colIndex=0;
-        for (std::vector<double>::const_iterator jt = it->begin(); jt != it->end(); ++jt, colIndex++)
-            MTM(rowIndex, colIndex) = *jt;
-        rowIndex++;
-    }
-#endif
+    rows.resize(row, rows.cols());
+    rows.setFromTriplets(triplets.begin(), triplets.end());
+}
 
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
-    }
-    for (unsigned i=0; i<ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
+/**
+ * Appends the rows of a smoothing functional, scaled by the root of its weight.
+ */
+static void AppendSmoothRows(const Eigen::SparseMatrix<double>& rows, double fWeight,
+                             int& offset, std::vector< Eigen::Triplet<double> >& triplets)
+{
+    if (fWeight <= 0.0 || rows.rows() == 0)
+        return;
+    double fScale = sqrt(fWeight);
+    for (int k=0; k<rows.outerSize(); k++) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(rows, k); it; ++it)
+            triplets.push_back(Eigen::Triplet<double>(offset + it.row(), it.col(), fScale * it.value()));
     }
+    offset += rows.rows();
+}
+}
 
-    // Loese das LGS mit der LU-Zerlegung
-    math_Gauss mgGaussX(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussY(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM+fWeight*_clSmoothMatrix);
+void BSplineParameterCorrection::DoParameterCorrection(int iIter)
+{
+    int i=0;
+    double fMaxDiff=0.0, fMaxScalar=1.0;
+    double fError=0.0, fLastError=DBL_MAX;
+    double fWeight = _fSmoothInfluence;
 
-    mgGaussX.Solve(Mbx,Xx);
-    if (!mgGaussX.IsDone())
-        return false;
+    Base::SequencerLauncher seq("Calc surface...", iIter);
 
-    mgGaussY.Solve(Mby,Xy);
-    if (!mgGaussY.IsDone())
-        return false;
+    do {
+        fMaxScalar = 1.0;
+        fMaxDiff   = 0.0;
+        fError     = 0.0;
 
-    mgGaussZ.Solve(Mbz,Xz);
-    if (!mgGaussZ.IsDone())
-        return false;
+        Handle(Geom_BSplineSurface) pclBSplineSurf = new Geom_BSplineSurface(_vCtrlPntsOfSurf,
+                                                    _vUKnots, _vVKnots, _vUMults, _vVMults, _usUOrder-1, _usVOrder-1);
 
-    unsigned ulIdx=0;
-    for (unsigned j=0;j<_usUCtrlpoints;j++) {
-        for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx),Xy(ulIdx),Xz(ulIdx));
-            ulIdx++;
+        // the error below is measured with the parameters the surface was fitted to,
+        // keep them in case the iteration stops before fitting to the corrected ones
+        TColgp_Array1OfPnt2d clLastParams(_pvcUVParam->Lower(), _pvcUVParam->Upper());
+        clLastParams = *_pvcUVParam;
+
+        // Die Punkte sind unabhaengig voneinander, daher werden sie blockweise parallel korrigiert
+        std::vector< std::pair<int, int> > ranges = MakeBlocks(_pvcPoints->Lower(), _pvcPoints->Upper());
+        ParameterProjection projection(pclBSplineSurf, *_pvcPoints, *_pvcUVParam);
+        QFuture<ProjectionResult> future = QtConcurrent::mapped
+            (ranges, boost::bind(&ParameterProjection::project, &projection, bp::_1));
+        future.waitForFinished();
+        for (QFuture<ProjectionResult>::const_iterator it = future.begin(); it != future.end(); ++it) {
+            fMaxDiff = std::max<double>(it->fMaxDiff, fMaxDiff);
+            fMaxScalar = std::min<double>(it->fMaxScalar, fMaxScalar);
+            fError += it->fError;
+        }
+
+        seq.next();
+
+        // Abbruch, wenn sich der Fehler der letzten Approximation kaum noch verringert
+        // (the surface is not solved again, so restore the parameters it was fitted to)
+        if (fError > fLastError * (1.0 - 1.0e-4)) {
+            *_pvcUVParam = clLastParams;
+            break;
+        }
+        fLastError = fError;
+
+        if (_bSmoothing) {
+            fWeight *= 0.5f;
+            SolveWithSmoothing(fWeight);
+        }
+        else {
+            SolveWithoutSmoothing();
         }
+
+        i++;
     }
+    while(i<iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
+}
 
-    return true;
+bool BSplineParameterCorrection::SolveWithoutSmoothing()
+{
+    // Loese das ueberbest. LGS durch QR-Zerlegung
+    LeastSquaresSystem system(_clUSpline, _clVSpline, _usUOrder, _usVOrder,
+                              _usUCtrlpoints, _usVCtrlpoints, *_pvcPoints, *_pvcUVParam);
+    return system.solve(nullptr, 0.0, _vCtrlPntsOfSurf);
+}
+
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    // Loese das ueberbest. LGS mit den Zeilen der Glaettungsterme durch QR-Zerlegung
+    LeastSquaresSystem system(_clUSpline, _clVSpline, _usUOrder, _usVOrder,
+                              _usUCtrlpoints, _usVCtrlpoints, *_pvcPoints, *_pvcUVParam);
+    return system.solve(&_clSmoothRows, fWeight, _vCtrlPntsOfSurf);
 }
 
 void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc, double fFirst, double fSecond, double fThird)
 {
     if (bRecalc) {
-        Base::SequencerLauncher seq("Initializing...", 3 * _usUCtrlpoints * _usUCtrlpoints * _usVCtrlpoints * _usVCtrlpoints);
+        Base::SequencerLauncher seq("Initializing...", 3 * (_vUKnots.Length()-1) * _usUOrder);
         CalcFirstSmoothMatrix(seq);
         CalcSecondSmoothMatrix(seq);
         CalcThirdSmoothMatrix(seq);
     }
 
-    _clSmoothMatrix = fFirst  * _clFirstMatrix  +
-                      fSecond * _clSecondMatrix +
-                      fThird  * _clThirdMatrix  ;
+    std::vector< Eigen::Triplet<double> > triplets;
+    int rows = 0;
+    AppendSmoothRows(_clFirstRows,  fFirst,  rows, triplets);
+    AppendSmoothRows(_clSecondRows, fSecond, rows, triplets);
+    AppendSmoothRows(_clThirdRows,  fThird,  rows, triplets);
+    _clSmoothRows.resize(rows, _usUCtrlpoints*_usVCtrlpoints);
+    _clSmoothRows.setFromTriplets(triplets.begin(), triplets.end());
 }
 
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clFirstMatrix(m,n) =   _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    // |Xu|^2 + |Xv|^2
+    std::vector<SmoothTerm> terms;
+    terms.push_back([](const double* du, const double* dv) { return du[1]*dv[0]; });
+    terms.push_back([](const double* du, const double* dv) { return du[0]*dv[1]; });
+    CalcSmoothRows(_clUSpline, _clVSpline, _vUKnots, _vVKnots, _usUOrder, _usVOrder,
+                   _usVCtrlpoints, terms, seq, _clFirstRows);
 }
 
 void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clSecondMatrix(m,n) =  _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          2*_clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    // |Xuu|^2 + 2|Xuv|^2 + |Xvv|^2
+    std::vector<SmoothTerm> terms;
+    terms.push_back([](const double* du, const double* dv) { return du[2]*dv[0]; });
+    terms.push_back([](const double* du, const double* dv) { return sqrt(2.0)*du[1]*dv[1]; });
+    terms.push_back([](const double* du, const double* dv) { return du[0]*dv[2]; });
+    CalcSmoothRows(_clUSpline, _clVSpline, _vUKnots, _vVKnots, _usUOrder, _usVOrder,
+                   _usVCtrlpoints, terms, seq, _clSecondRows);
 }
 
 void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clThirdMatrix(m,n) = _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,3) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,3) ;
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    // |Xuuu + Xuvv|^2 + |Xuuv + Xvvv|^2
+    std::vector<SmoothTerm> terms;
+    terms.push_back([](const double* du, const double* dv) { return du[3]*dv[0] + du[1]*dv[2]; });
+    terms.push_back([](const double* du, const double* dv) { return du[2]*dv[1] + du[0]*dv[3]; });
+    CalcSmoothRows(_clUSpline, _clVSpline, _vUKnots, _vVKnots, _usUOrder, _usVOrder,
+                   _usVCtrlpoints, terms, seq, _clThirdRows);
 }
 
 void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
@@ -1256,32 +1303,17 @@ void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInf
     ParameterCorrection::EnableSmoothing(bSmooth, fSmoothInfl);
 }
 
-const math_Matrix& BSplineParameterCorrection::GetFirstSmoothMatrix() const
-{
-    return _clFirstMatrix;
-}
-
-const math_Matrix& BSplineParameterCorrection::GetSecondSmoothMatrix() const
-{
-    return _clSecondMatrix;
-}
-
-const math_Matrix& BSplineParameterCorrection::GetThirdSmoothMatrix() const
-{
-    return _clThirdMatrix;
-}
-
-void BSplineParameterCorrection::SetFirstSmoothMatrix(const math_Matrix& rclMat)
+Eigen::SparseMatrix<double> BSplineParameterCorrection::GetFirstSmoothMatrix() const
 {
-    _clFirstMatrix = rclMat;
+    return Eigen::SparseMatrix<double>(_clFirstRows.transpose() * _clFirstRows);
 }
 
-void BSplineParameterCorrection::SetSecondSmoothMatrix(const math_Matrix& rclMat)
+Eigen::SparseMatrix<double> BSplineParameterCorrection::GetSecondSmoothMatrix() const
 {
-    _clSecondMatrix = rclMat;
+    return Eigen::SparseMatrix<double>(_clSecondRows.transpose() * _clSecondRows);
 }
 
-void BSplineParameterCorrection::SetThirdSmoothMatrix(const math_Matrix& rclMat)
+Eigen::SparseMatrix<double> BSplineParameterCorrection::GetThirdSmoothMatrix() const
 {
-    _clThirdMatrix = rclMat;
+    return Eigen::SparseMatrix<double>(_clThirdRows.transpose() * _clThirdRows);
 }
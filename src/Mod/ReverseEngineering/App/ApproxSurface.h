@@ -31,6 +31,7 @@
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <math_Matrix.hxx>
+#include <Eigen/Sparse>
 
 #include <Base/Vector3D.h>
 
@@ -390,13 +391,14 @@ protected:
     virtual void DoParameterCorrection(int iIter);
 
     /**
-     * Loest ein ueberbestimmtes LGS mit Hilfe der Householder-Transformation
+     * Loest ein ueberbestimmtes LGS durch eine duenn besetzte QR-Zerlegung. Die Zeilen werden
+     * blockweise parallel aufgestellt
      */
     virtual bool SolveWithoutSmoothing();
 
     /**
-     * Loest ein regulaeres Gleichungssystem durch LU-Zerlegung. Es fliessen je nach Gewichtung
-     * Glaettungsterme mit ein
+     * Loest ein ueberbestimmtes LGS durch eine duenn besetzte QR-Zerlegung. Es fliessen je nach
+     * Gewichtung die Zeilen der Glaettungsterme mit ein
      */
     virtual bool SolveWithSmoothing(double fWeight);
 
@@ -414,32 +416,17 @@ public:
     /**
      * Gibt die erste Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetFirstSmoothMatrix() const;
+    virtual Eigen::SparseMatrix<double> GetFirstSmoothMatrix() const;
 
     /**
      * Gibt die zweite Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetSecondSmoothMatrix() const;
+    virtual Eigen::SparseMatrix<double> GetSecondSmoothMatrix() const;
 
     /**
      * Gibt die dritte Matrix der Glaettungsterme zurueck, falls berechnet
      */
-    virtual const math_Matrix& GetThirdSmoothMatrix() const;
-
-    /**
-     * Setzt die erste Matrix der Glaettungsterme 
-     */
-    virtual void SetFirstSmoothMatrix(const math_Matrix& rclMat);
-
-    /**
-     * Setzt die zweite Matrix der Glaettungsterme
-     */
-    virtual void SetSecondSmoothMatrix(const math_Matrix& rclMat);
-
-    /**
-     * Setzt die dritte Matrix der Glaettungsterme
-     */
-    virtual void SetThirdSmoothMatrix(const math_Matrix& rclMat);
+    virtual Eigen::SparseMatrix<double> GetThirdSmoothMatrix() const;
 
     /**
      * Verwende Glaettungsterme
@@ -454,35 +441,37 @@ public:
 
 protected:
     /**
-     * Berechnet die Matrix zu den Glaettungstermen
+     * Berechnet die Zeilen zu den Glaettungstermen
      * (siehe Dissertation U.Dietz)
      */
     virtual void CalcSmoothingTerms(bool bRecalc, double fFirst, double fSecond, double fThird);
 
     /**
-     * Berechnet die Matrix zum ersten Glaettungsterm
+     * Berechnet die Zeilen zum ersten Glaettungsterm
      * (siehe Diss. U.Dietz)
      */
     virtual void CalcFirstSmoothMatrix(Base::SequencerLauncher&);
 
     /**
-     * Berechnet die Matrix zum zweiten Glaettunsterm
+     * Berechnet die Zeilen zum zweiten Glaettunsterm
      * (siehe Diss. U.Dietz)
      */
     virtual void CalcSecondSmoothMatrix(Base::SequencerLauncher&);
 
     /**
-     * Berechnet die Matrix zum dritten Glaettungsterm
+     * Berechnet die Zeilen zum dritten Glaettungsterm
      */
     virtual void CalcThirdSmoothMatrix(Base::SequencerLauncher&);
 
 protected:
     BSplineBasis           _clUSpline;        //! B-Spline-Basisfunktion in u-Richtung
     BSplineBasis           _clVSpline;        //! B-Spline-Basisfunktion in v-Richtung
-    math_Matrix            _clSmoothMatrix;   //! Matrix der Glaettungsfunktionale
-    math_Matrix            _clFirstMatrix;    //! Matrix der 1. Glaettungsfunktionale
-    math_Matrix            _clSecondMatrix;   //! Matrix der 2. Glaettungsfunktionale
-    math_Matrix            _clThirdMatrix;    //! Matrix der 3. Glaettungsfunktionale
+    // Ein Glaettungsfunktional ist ein Integral ueber Quadrate, seine Matrix ist daher
+    // Zeilen^T * Zeilen. Gespeichert werden nur die duenn besetzten Zeilen.
+    Eigen::SparseMatrix<double> _clSmoothRows;  //! Zeilen der Glaettungsfunktionale
+    Eigen::SparseMatrix<double> _clFirstRows;   //! Zeilen des 1. Glaettungsfunktionals
+    Eigen::SparseMatrix<double> _clSecondRows;  //! Zeilen des 2. Glaettungsfunktionals
+    Eigen::SparseMatrix<double> _clThirdRows;   //! Zeilen des 3. Glaettungsfunktionals
 };
 
 } // namespace Reen
@@ -24,3 +24,5 @@
 # *   USA                                                                   *
 # *                                                                         *
 # ***************************************************************************/
+
+FreeCAD.__unit_test__ += [ "TestReverseEngineeringApp" ]
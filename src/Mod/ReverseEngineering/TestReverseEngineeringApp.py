@@ -0,0 +1,54 @@
+# Unit tests for the ReverseEngineering module
+# LGPL
+
+import FreeCAD, unittest, Part, ReverseEngineering, math, random
+
+
+def sampleSurface(size=25):
+    # z = sin(x/3)*cos(y/3) on [0,10]x[0,10], slightly jittered in x and y
+    r = random.Random(0)
+    points = []
+    for i in range(size):
+        for j in range(size):
+            x = 10.0 * i / (size - 1) + r.uniform(-0.05, 0.05)
+            y = 10.0 * j / (size - 1) + r.uniform(-0.05, 0.05)
+            points.append((x, y, math.sin(x / 3.0) * math.cos(y / 3.0)))
+    return points
+
+
+def fitErrors(surface, points):
+    errors = []
+    for p in points:
+        p = FreeCAD.Vector(*p)
+        u, v = surface.parameter(p)
+        errors.append((surface.value(u, v) - p).Length)
+    return max(errors), sum(errors) / len(errors)
+
+
+class ApproxSurfaceCases(unittest.TestCase):
+    def setUp(self):
+        self.points = sampleSurface()
+
+    def approx(self, smooth, iterations=5):
+        return ReverseEngineering.approxSurface(Points=self.points, NbUPoles=10, NbVPoles=10,
+                                                Smooth=smooth, Weight=0.1, Grad=1.0,
+                                                Iterations=iterations)
+
+    def testWithoutSmoothing(self):
+        maxError, meanError = fitErrors(self.approx(False), self.points)
+        self.assertLess(maxError, 0.02)
+        self.assertLess(meanError, 0.005)
+
+    def testWithSmoothing(self):
+        # smoothing trades some accuracy for fairness
+        maxError, meanError = fitErrors(self.approx(True), self.points)
+        self.assertLess(maxError, 0.2)
+        self.assertLess(meanError, 0.05)
+
+    def testEarlyStop(self):
+        # more iterations stop once the error no longer decreases, the surface
+        # returned then must not be worse than after a few iterations
+        few = fitErrors(self.approx(False, 2), self.points)
+        many = fitErrors(self.approx(False, 50), self.points)
+        self.assertLess(many[1], few[1] * 1.05 + 1e-6)
+        self.assertLess(many[0], 0.02)
@@ -55,6 +55,13 @@ public:
         add_varargs_method("simulateToFile",&Module::simulateToFile,
             "simulateToFile(Robot,Trajectory,TickSize,FileName) - runs the simulation and write the result to a file."
         );
+        add_varargs_method("sampleTrajectory",&Module::sampleTrajectory,
+            "sampleTrajectory(Robot,Trajectory,TickSize,[Parallel=True]) - solves the whole trajectory in steps of TickSize.\n"
+            "Returns a list of (Time,Reachable,(Axis1,...,Axis6),AtLimit,OverSpeed) where AtLimit and\n"
+            "OverSpeed are bit masks of the axes standing at a soft end or moving too fast.\n"
+            "With Parallel=False the samples are solved one after the other.\n"
+            "The robot itself is not moved."
+        );
         initialize("This module is the Robot module."); // register with Python
     }
 
@@ -84,6 +91,47 @@ private:
 
         return Py::Float(0.0);
     }
+    Py::Object sampleTrajectory(const Py::Tuple& args)
+    {
+        PyObject *pcRobObj;
+        PyObject *pcTracObj;
+        double tick;
+        PyObject *parallel = Py_True;
+
+        if (!PyArg_ParseTuple(args.ptr(), "O!O!d|O!", &(Robot6AxisPy::Type), &pcRobObj,
+                                                      &(TrajectoryPy::Type), &pcTracObj,
+                                                      &tick, &PyBool_Type, &parallel))
+            throw Py::Exception();
+
+        Robot::Trajectory &Trac = * static_cast<TrajectoryPy*>(pcTracObj)->getTrajectoryPtr();
+        if (Trac.getSize() < 2)
+            throw Py::ValueError("Trajectory needs at least two waypoints");
+
+        try {
+            // the simulation moves the robot to the start, so work on a copy
+            Robot::Robot6Axis Rob = * static_cast<Robot6AxisPy*>(pcRobObj)->getRobot6AxisPtr();
+            Simulation Sim(Trac,Rob);
+            std::vector<SimulationSample> samples = Sim.sampleTrajectory(tick, PyObject_IsTrue(parallel) ? true : false);
+
+            Py::List list;
+            for (std::vector<SimulationSample>::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+                Py::Tuple axis(6);
+                for (int i=0; i<6; i++)
+                    axis.setItem(i, Py::Float(it->Axis[i]));
+                Py::Tuple item(5);
+                item.setItem(0, Py::Float(it->Time));
+                item.setItem(1, Py::Boolean(it->Reachable));
+                item.setItem(2, axis);
+                item.setItem(3, Py::Long(static_cast<long>(it->AtLimit)));
+                item.setItem(4, Py::Long(static_cast<long>(it->OverSpeed)));
+                list.append(item);
+            }
+            return list;
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
 };
 
 PyObject* initModule()
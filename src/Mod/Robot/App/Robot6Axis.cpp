@@ -228,28 +228,34 @@ void Robot6Axis::Restore(XMLReader &reader)
 
 bool Robot6Axis::setTo(const Placement &To)
 {
-    //Creation of the solvers:
-    ChainFkSolverPos_recursive fksolver1(Kinematic);//Forward position solver
-    ChainIkSolverVel_pinv iksolver1v(Kinematic);//Inverse velocity solver
-    ChainIkSolverPos_NR_JL iksolver1(Kinematic,Min,Max,fksolver1,iksolver1v,100,1e-6);//Maximum 100 iterations, stop at accuracy 1e-6
-
     //Creation of jntarrays:
     JntArray result(Kinematic.getNrOfJoints());
 
-    //Set destination frame
-    Frame F_dest = Frame(KDL::Rotation::Quaternion(To.getRotation()[0],To.getRotation()[1],To.getRotation()[2],To.getRotation()[3]),KDL::Vector(To.getPosition()[0],To.getPosition()[1],To.getPosition()[2]));
-
     // solve
-    if (iksolver1.CartToJnt(Actuall,F_dest,result) < 0) {
+    if (!calcAxis(To,Actuall,result)) {
         return false;
     }
     else {
         Actuall = result;
-        Tcp = F_dest;
+        Tcp = toFrame(To);
         return true;
     }
 }
 
+bool Robot6Axis::calcAxis(const Placement &To, const JntArray &Start, JntArray &Result) const
+{
+    //Creation of the solvers:
+    ChainFkSolverPos_recursive fksolver1(Kinematic);//Forward position solver
+    ChainIkSolverVel_pinv iksolver1v(Kinematic);//Inverse velocity solver
+    ChainIkSolverPos_NR_JL iksolver1(Kinematic,Min,Max,fksolver1,iksolver1v,100,1e-6);//Maximum 100 iterations, stop at accuracy 1e-6
+
+    //Set destination frame
+    Frame F_dest = Frame(KDL::Rotation::Quaternion(To.getRotation()[0],To.getRotation()[1],To.getRotation()[2],To.getRotation()[3]),KDL::Vector(To.getPosition()[0],To.getPosition()[1],To.getPosition()[2]));
+
+    // solve
+    return iksolver1.CartToJnt(Start,F_dest,Result) >= 0;
+}
+
 Base::Placement Robot6Axis::getTcp(void)
 {
     double x,y,z,w;
@@ -287,3 +293,8 @@ double Robot6Axis::getAxis(int Axis)
 {
     return RotDir[Axis] * (Actuall(Axis)/(M_PI/180)); // radian to degree
 }
+
+double Robot6Axis::toAxisAngle(int Axis, double Value) const
+{
+    return RotDir[Axis] * (Value/(M_PI/180)); // radian to degree
+}
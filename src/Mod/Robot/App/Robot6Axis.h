@@ -69,6 +69,14 @@ public:
     
     /// set the robot to that position, calculates the Axis
 	bool setTo(const Base::Placement &To);
+    /// calculate the Axis (in rad) for a position starting at Start, without moving the robot
+    bool calcAxis(const Base::Placement &To, const KDL::JntArray &Start, KDL::JntArray &Result) const;
+    /// the actual Axis in rad, as used by calcAxis()
+    const KDL::JntArray &getJointArray(void) const {return Actuall;}
+    /// convert an Axis value of calcAxis() to degrees like getAxis()
+    double toAxisAngle(int Axis, double Value) const;
+    /// max velocity of the Axis in °/s
+    double getVelocity(int Axis) const {return Velocity[Axis];}
 	bool setAxis(int Axis,double Value);
 	double getAxis(int Axis);
     double getMaxAngle(int Axis);
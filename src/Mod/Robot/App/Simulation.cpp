@@ -24,9 +24,13 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
-
+# include <algorithm>
+# include <cmath>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "kdl_cp/chain.hpp"
 #include "kdl_cp/frames_io.hpp"
 
@@ -34,6 +38,7 @@
 #include <iostream>
 
 #include <Base/Console.h>
+#include <Base/Tools.h>
 
 
 #include "Simulation.h"
@@ -118,3 +123,84 @@ void Simulation::reset(void)
     Axis[5] = Rob.getAxis(5);
 
 }
+
+std::vector<SimulationSample> Simulation::sampleTrajectory(double tick, bool parallel) const
+{
+    std::vector<SimulationSample> samples;
+    double duration = Trac.getDuration();
+    if (tick <= 0.0 || duration <= 0.0)
+        return samples;
+
+    // the KDL trajectory caches the last used segment, so get the positions serially
+    std::size_t count = static_cast<std::size_t>(std::ceil(duration / tick - 1e-9)) + 1;
+    samples.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        SimulationSample &sample = samples[i];
+        sample.Time = std::min(i * tick, duration);
+        sample.Tcp = Trac.getPosition(sample.Time) * Tool.inverse();
+        sample.Reachable = false;
+        sample.AtLimit = 0;
+        sample.OverSpeed = 0;
+    }
+
+    // Solve runs of neighbouring samples in parallel. Each run starts at the actual
+    // axis of the robot and then goes on from its previous sample. An unreachable
+    // sample keeps the axis of its predecessor, like the robot does in setToTime().
+    std::vector<JntArray> joints(count, JntArray(6));
+    auto solve = [&](std::size_t index, const JntArray &start) {
+        bool ok = Rob.calcAxis(samples[index].Tcp, start, joints[index]);
+        if (!ok)
+            joints[index] = start;
+        samples[index].Reachable = ok;
+    };
+
+    int threads = std::max(QThread::idealThreadCount(), 1);
+    std::size_t runSize = std::max<std::size_t>(16, count / (4 * threads) + 1);
+    if (!parallel)
+        runSize = count;
+    std::vector<std::size_t> runs;
+    for (std::size_t i = 0; i < count; i += runSize)
+        runs.push_back(i);
+
+    const JntArray &start = Rob.getJointArray();
+    QtConcurrent::blockingMap(runs, [&](std::size_t first) {
+        std::size_t last = std::min(first + runSize, count);
+        solve(first, start);
+        for (std::size_t i = first + 1; i < last; i++)
+            solve(i, joints[i - 1]);
+    });
+
+    // Re-solve the start of each run from the end of the one before. As soon as a
+    // sample comes out as in the parallel pass, all following ones do as well.
+    // Robot6Axis::calcAxis() stops at an accuracy of 1e-6, so a solution from a
+    // different start only agrees up to about that.
+    const double solverAccuracy = 1e-5;
+    for (std::size_t k = 1; k < runs.size(); k++) {
+        for (std::size_t i = runs[k]; i < count; i++) {
+            JntArray old = joints[i];
+            bool wasReachable = samples[i].Reachable;
+            solve(i, joints[i - 1]);
+            if (samples[i].Reachable == wasReachable && Equal(joints[i], old, solverAccuracy))
+                break;
+        }
+    }
+
+    // report soft ends and axis velocities
+    const double eps = 1e-3; // degrees
+    for (std::size_t i = 0; i < count; i++) {
+        SimulationSample &sample = samples[i];
+        for (int j = 0; j < 6; j++) {
+            sample.Axis[j] = Rob.toAxisAngle(j, joints[i](j));
+            double angle = Base::toDegrees<double>(joints[i](j));
+            if (angle >= Rob.getMaxAngle(j) - eps || angle <= Rob.getMinAngle(j) + eps)
+                sample.AtLimit |= 1 << j;
+            if (i > 0 && sample.Time > samples[i - 1].Time) {
+                double speed = std::fabs(sample.Axis[j] - samples[i - 1].Axis[j]) / (sample.Time - samples[i - 1].Time);
+                if (speed > Rob.getVelocity(j))
+                    sample.OverSpeed |= 1 << j;
+            }
+        }
+    }
+
+    return samples;
+}
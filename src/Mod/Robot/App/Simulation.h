@@ -27,6 +27,7 @@
 #include <Base/Vector3D.h>
 #include <Base/Placement.h>
 #include <string>
+#include <vector>
 
 #include "Trajectory.h"
 #include "Robot6Axis.h"
@@ -34,6 +35,16 @@
 namespace Robot
 {
 
+/// Result of the batch kinematics for one point in time of a trajectory
+struct SimulationSample {
+    double Time;
+    Base::Placement Tcp;  // needed robot position (tool already removed)
+    bool Reachable;
+    double Axis[6];       // in degrees, like Robot6Axis::getAxis()
+    int AtLimit;          // bit n set if Axis n+1 stands at a soft end
+    int OverSpeed;        // bit n set if Axis n+1 moves faster than its velocity
+};
+
 /** Algo class for projecting shapes and creating SVG output of it
  */
 class RobotExport Simulation
@@ -55,6 +66,13 @@ public:
     void setToTime(float t);
     // apply the start axis angles and set to time 0. Restores the exact start position
     void reset(void);
+    /** Solve the whole trajectory in steps of tick without moving the robot.
+     *  Each sample starts the solver at the axis of its predecessor, so the
+     *  result is the same as stepping through the trajectory with setToTime(),
+     *  up to the accuracy of the solver. With \a parallel false the samples are
+     *  solved strictly one after the other.
+     */
+    std::vector<SimulationSample> sampleTrajectory(double tick, bool parallel=true) const;
 
 	double Pos;
 	double Axis[6];
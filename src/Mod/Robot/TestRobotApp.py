@@ -0,0 +1,40 @@
+# Unit tests for the Robot module
+# LGPL
+
+import FreeCAD, unittest, Robot
+from FreeCAD import Placement, Vector, Rotation
+
+
+class SampleTrajectoryCases(unittest.TestCase):
+    def setUp(self):
+        self.robot = Robot.Robot6Axis()
+        start = self.robot.Tcp
+        points = []
+        for i in range(6):
+            pos = start.Base + Vector(10.0 * i, 5.0 * (i % 2), -8.0 * i)
+            points.append(Robot.Waypoint(Placement(pos, start.Rotation), "LIN", "Pt"))
+        self.trajectory = Robot.Trajectory(points)
+
+    def testParallelMatchesSerial(self):
+        # enough samples for several runs of the parallel pass
+        tick = self.trajectory.Duration / 200.0
+        serial = Robot.sampleTrajectory(self.robot, self.trajectory, tick, False)
+        parallel = Robot.sampleTrajectory(self.robot, self.trajectory, tick, True)
+        self.assertTrue(len(serial) > 100)
+        self.assertEqual(len(serial), len(parallel))
+        for s, p in zip(serial, parallel):
+            self.assertAlmostEqual(s[0], p[0])
+            self.assertEqual(s[1], p[1])
+            for a, b in zip(s[2], p[2]):
+                # degrees, the solver stops at an accuracy of 1e-6
+                self.assertAlmostEqual(a, b, delta=1e-3)
+
+    def testRobotNotMoved(self):
+        axis = [self.robot.Axis1, self.robot.Axis2, self.robot.Axis3,
+                self.robot.Axis4, self.robot.Axis5, self.robot.Axis6]
+        Robot.sampleTrajectory(self.robot, self.trajectory, self.trajectory.Duration / 20.0)
+        self.assertEqual(axis, [self.robot.Axis1, self.robot.Axis2, self.robot.Axis3,
+                                self.robot.Axis4, self.robot.Axis5, self.robot.Axis6])
+
+    def tearDown(self):
+        pass
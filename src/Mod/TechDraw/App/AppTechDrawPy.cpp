@@ -95,6 +95,9 @@ public:
         add_varargs_method("findOuterWire",&Module::findOuterWire,
             "wire = findOuterWire(edgeList) -- Planar graph traversal finds OuterWire in edge pile."
         );
+        add_varargs_method("splitEdgesAtVertices",&Module::splitEdgesAtVertices,
+            "[edges] = splitEdgesAtVertices(edgeList) -- Split edges where an end vertex of another edge lies on them."
+        );
         add_varargs_method("findShapeOutline",&Module::findShapeOutline,
             "wire = findShapeOutline(shape,scale,direction) -- Project shape in direction and find outer wire of result."
         );
@@ -272,6 +275,43 @@ private:
         return Py::asObject(outerWire);
     }
 
+    Py::Object splitEdgesAtVertices(const Py::Tuple& args)
+    {
+        PyObject *pcObj;
+        if (!PyArg_ParseTuple(args.ptr(), "O!", &(PyList_Type), &pcObj)) {
+            throw Py::TypeError("expected (listofedges)");
+        }
+
+        std::vector<TopoDS_Edge> edgeList;
+        try {
+            Py::Sequence list(pcObj);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                if (PyObject_TypeCheck((*it).ptr(), &(Part::TopoShapeEdgePy::Type))) {
+                    const TopoDS_Shape& sh = static_cast<TopoShapePy*>((*it).ptr())->
+                        getTopoShapePtr()->getShape();
+                    const TopoDS_Edge e = TopoDS::Edge(sh);
+                    edgeList.push_back(e);
+                }
+            }
+        }
+        catch (Standard_Failure& e) {
+
+            throw Py::Exception(Part::PartExceptionOCCError, e.GetMessageString());
+        }
+
+        PyObject* result = PyList_New(0);
+        try {
+            std::vector<TopoDS_Edge> splitList = DrawProjectSplit::splitEdgesAtVertices(edgeList);
+            for (auto& e:splitList) {
+                PyList_Append(result,new TopoShapeEdgePy(new TopoShape(e)));
+            }
+        }
+        catch (Standard_Failure& e) {
+            throw Py::Exception(Part::PartExceptionOCCError, e.GetMessageString());
+        }
+        return Py::asObject(result);
+    }
+
     Py::Object findShapeOutline(const Py::Tuple& args)
     {
         PyObject *pcObjShape;
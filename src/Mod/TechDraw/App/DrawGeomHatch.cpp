@@ -36,7 +36,9 @@
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
 #include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
 
+#include <BRepAdaptor_Curve.hxx>
 #include <BRepAlgoAPI_Common.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
@@ -44,6 +46,8 @@
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
 #include <BRepTools.hxx>
+#include <BRepTools_WireExplorer.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
 #include <Standard_PrimitiveTypes.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
@@ -60,6 +64,11 @@
 
 #endif
 
+#include <algorithm>
+#include <limits>
+
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Console.h>
@@ -231,6 +240,46 @@ std::vector<LineSet>  DrawGeomHatch::getTrimmedLines(int i)   //get the trimmed
     return getTrimmedLines(source, m_lineSets,i, ScalePattern.getValue());
 }
 
+//! get the trimmed hatch lines for several faces. The faces are built here,
+//! the clipping runs in parallel.
+std::vector<std::vector<LineSet> > DrawGeomHatch::getTrimmedLines(const std::vector<int>& faces)
+{
+    std::vector<std::vector<LineSet> > result(faces.size());
+    DrawViewPart* source = getSourceView();
+    if (!source ||
+        !source->hasGeometry()) {
+        Base::Console().Log("DGH::getTrimmedLines - no source geometry\n");
+        return result;
+    }
+
+    //extractFace fixes up the shared edges of the view, so is not run in parallel
+    std::vector<TopoDS_Face> occFaces;
+    std::vector<int> jobs;
+    for (auto& iface: faces) {
+        jobs.push_back(occFaces.size());
+        occFaces.push_back(extractFace(source, iface));
+    }
+
+    //an exception escaping a worker thread would only surface as QUnhandledException,
+    //so a failing face is logged and stays unhatched
+    double scale = ScalePattern.getValue();
+    QtConcurrent::blockingMap(jobs, [&](int i) {
+        if (occFaces[i].IsNull()) {
+            return;
+        }
+        try {
+            result[i] = getTrimmedLines(source, m_lineSets, occFaces[i], scale);
+        }
+        catch (Base::Exception& e) {
+            Base::Console().Log("DGH::getTrimmedLines - face %d failed - %s\n", faces[i], e.what());
+        }
+        catch (Standard_Failure& e) {
+            Base::Console().Log("DGH::getTrimmedLines - face %d failed - OCC error - %s\n", faces[i], e.GetMessageString());
+        }
+    });
+    return result;
+}
+
 /* static */
 std::vector<LineSet>  DrawGeomHatch::getTrimmedLinesSection(DrawViewSection* source,
                                                             std::vector<LineSet> lineSets,
@@ -271,51 +320,20 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
         return result;
     }
 
-    TopoDS_Face face = f;
-
-    Bnd_Box bBox;
-    BRepBndLib::Add(face, bBox);
-    bBox.SetGap(0.0);
+    std::vector<std::vector<Base::Vector3d> > polygons = getBoundaryPolygons(f);
 
     for (auto& ls: lineSets) {
         PATLineSpec hl = ls.getPATLineSpec();
-        std::vector<TopoDS_Edge> candidates = DrawGeomHatch::makeEdgeOverlay(hl, bBox, scale);   //completely cover face bbox with lines
-
-        //make Compound for this linespec
-        BRep_Builder builder;
-        TopoDS_Compound grid;
-        builder.MakeCompound(grid);
-        for (auto& c: candidates) {
-           builder.Add(grid, c);
-        }
-
-        //Common(Compound,Face)
-        BRepAlgoAPI_Common mkCommon(face, grid);
-        if ((!mkCommon.IsDone())  ||
-            (mkCommon.Shape().IsNull()) ) {
-            Base::Console().Log("INFO - DGH::getTrimmedLines - Common creation failed\n");
-            return result;
-        }
-        TopoDS_Shape common = mkCommon.Shape();
+        std::vector<TopoDS_Edge> resultEdges = clipHatchLines(hl, polygons, scale);
 
         //save the boundingBox of hatch pattern
         Bnd_Box overlayBox;
         overlayBox.SetGap(0.0);
-        BRepBndLib::Add(common, overlayBox);
-        ls.setBBox(overlayBox);
-
-        //get resulting edges
-        std::vector<TopoDS_Edge> resultEdges;
-        TopTools_IndexedMapOfShape mapOfEdges;
-        TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
-        for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
-            const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
-            if (edge.IsNull()) {
-                Base::Console().Log("INFO - DGH::getTrimmedLines - edge: %d is NULL\n",i);
-                continue;
-            }
-            resultEdges.push_back(edge);
+        for (auto& e: resultEdges) {
+            overlayBox.Add(BRep_Tool::Pnt(TopExp::FirstVertex(e)));
+            overlayBox.Add(BRep_Tool::Pnt(TopExp::LastVertex(e)));
         }
+        ls.setBBox(overlayBox);
 
         std::vector<TechDraw::BaseGeom*> resultGeoms;
         int i = 0;
@@ -432,6 +450,207 @@ std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box
     return result;
 }
 
+/* static */
+//! approximate the wires of a face in the XY plane by closed polygons
+std::vector<std::vector<Base::Vector3d> > DrawGeomHatch::getBoundaryPolygons(const TopoDS_Face& face)
+{
+    std::vector<std::vector<Base::Vector3d> > result;
+    if (face.IsNull()) {
+        return result;
+    }
+
+    for (TopExp_Explorer expWire(face, TopAbs_WIRE); expWire.More(); expWire.Next()) {
+        std::vector<Base::Vector3d> polygon;
+        BRepTools_WireExplorer expEdge(TopoDS::Wire(expWire.Current()), face);
+        for (; expEdge.More(); expEdge.Next()) {
+            const TopoDS_Edge& edge = expEdge.Current();
+            std::vector<Base::Vector3d> points;
+            try {
+                BRepAdaptor_Curve adapt(edge);
+                if (adapt.GetType() == GeomAbs_Line) {
+                    gp_Pnt p1 = adapt.Value(adapt.FirstParameter());
+                    gp_Pnt p2 = adapt.Value(adapt.LastParameter());
+                    points.emplace_back(p1.X(), p1.Y(), 0.0);
+                    points.emplace_back(p2.X(), p2.Y(), 0.0);
+                } else {
+                    GCPnts_TangentialDeflection discretizer(adapt, 0.1, 0.001);
+                    for (int i = 1; i <= discretizer.NbPoints(); i++) {
+                        gp_Pnt p = discretizer.Value(i);
+                        points.emplace_back(p.X(), p.Y(), 0.0);
+                    }
+                }
+            }
+            catch (Standard_Failure& e) {
+                Base::Console().Log("DGH::getBoundaryPolygons - OCC error - %s\n", e.GetMessageString());
+                continue;
+            }
+            if (edge.Orientation() == TopAbs_REVERSED) {
+                std::reverse(points.begin(), points.end());
+            }
+            //consecutive edges share their end points
+            auto first = points.begin();
+            if (!polygon.empty() && !points.empty()) {
+                first++;
+            }
+            polygon.insert(polygon.end(), first, points.end());
+        }
+        if ((polygon.size() > 1) &&
+            polygon.front().IsEqual(polygon.back(), Precision::Confusion())) {
+            polygon.pop_back();
+        }
+        if (polygon.size() > 2) {
+            result.push_back(polygon);
+        }
+    }
+    return result;
+}
+
+/* static */
+//! intersect the hatch lines of a PATLineSpec directly with the boundary
+//! polygons of a face. Each line is cut by its crossings with the polygons
+//! (even-odd rule), so holes are handled the same way as the outer wire.
+//! The lines are the same as those of makeEdgeOverlay, so the dash pattern
+//! lines up from the pattern origin as before.
+std::vector<TopoDS_Edge> DrawGeomHatch::clipHatchLines(PATLineSpec hl,
+                                                       const std::vector<std::vector<Base::Vector3d> >& polygons,
+                                                       double scale)
+{
+    std::vector<TopoDS_Edge> result;
+    if (polygons.empty()) {
+        return result;
+    }
+
+    //only dealing with angles -180:180 for now
+    double angle = hl.getAngle();
+    if (angle > 90.0) {
+         angle = -(180.0 - angle);
+    } else if (angle < -90.0) {
+        angle = (180 + angle);
+    }
+
+    //direction of the lines and offset from one line to the next
+    Base::Vector3d dir;
+    Base::Vector3d step;
+    if (angle == 0.0) {
+        dir = Base::Vector3d(1.0, 0.0, 0.0);
+        step = Base::Vector3d(0.0, hl.getInterval() * scale, 0.0);
+    } else if ((angle == 90.0) ||
+               (angle == -90.0)) {
+        dir = Base::Vector3d(0.0, 1.0, 0.0);
+        step = Base::Vector3d(hl.getInterval() * scale, 0.0, 0.0);
+    } else {
+        double radians = angle * M_PI / 180.0;
+        dir = Base::Vector3d(cos(radians), sin(radians), 0.0);
+        if (dir.y < 0.0) {
+            dir = -dir;              //lines run bottom to top
+        }
+        step = Base::Vector3d(hl.getIntervalX() * scale, 0.0, 0.0);
+    }
+
+    //line k is the set of points p with normal*p == base + k*interval
+    Base::Vector3d normal(-dir.y, dir.x, 0.0);
+    Base::Vector3d origin = hl.getOrigin();
+    double base = normal * origin;
+    double interval = fabs(normal * step);
+    if (interval < Precision::Confusion()) {
+        Base::Console().Log("DGH::clipHatchLines - interval is zero\n");
+        return result;
+    }
+
+    double cMin = std::numeric_limits<double>::max();
+    double cMax = -std::numeric_limits<double>::max();
+    for (auto& polygon: polygons) {
+        for (auto& p: polygon) {
+            double c = normal * p;
+            cMin = std::min(cMin, c);
+            cMax = std::max(cMax, c);
+        }
+    }
+    long first = (long) ceil((cMin - base) / interval);
+    long last = (long) floor((cMax - base) / interval);
+    if (last < first) {
+        return result;
+    }
+
+    //positions along dir where each line crosses the boundary
+    std::vector<std::vector<double> > crossings(last - first + 1);
+    for (auto& polygon: polygons) {
+        size_t count = polygon.size();
+        for (size_t i = 0; i < count; i++) {
+            const Base::Vector3d& p = polygon[i];
+            const Base::Vector3d& q = polygon[(i + 1) % count];
+            double cp = normal * p;
+            double cq = normal * q;
+            if (cp == cq) {
+                continue;            //parallel to the lines
+            }
+            //lines with lo <= c < hi, so a shared vertex counts once
+            double lo = std::min(cp, cq);
+            double hi = std::max(cp, cq);
+            long kLo = std::max(first, (long) ceil((lo - base) / interval));
+            long kHi = std::min(last, (long) ceil((hi - base) / interval) - 1);
+            for (long k = kLo; k <= kHi; k++) {
+                double t = (base + k * interval - cp) / (cq - cp);
+                crossings[k - first].push_back(dir * (p + (q - p) * t));
+            }
+        }
+    }
+
+    for (long k = first; k <= last; k++) {
+        std::vector<double>& lineCrossings = crossings[k - first];
+        std::sort(lineCrossings.begin(), lineCrossings.end());
+        Base::Vector3d linePoint = normal * (base + k * interval);
+        for (size_t i = 0; i + 1 < lineCrossings.size(); i += 2) {
+            if (lineCrossings[i + 1] - lineCrossings[i] < Precision::Confusion()) {
+                continue;
+            }
+            result.push_back(makeLine(linePoint + dir * lineCrossings[i],
+                                      linePoint + dir * lineCrossings[i + 1]));
+        }
+    }
+    return result;
+}
+
+/* static */
+//! trim the hatch lines of a PATLineSpec with a boolean common of the face
+//! and the overlay lines. This was the only method before clipHatchLines and
+//! is kept as a reference for it.
+std::vector<TopoDS_Edge> DrawGeomHatch::clipHatchLinesBoolean(PATLineSpec hl,
+                                                              const TopoDS_Face& face,
+                                                              double scale)
+{
+    std::vector<TopoDS_Edge> result;
+
+    Bnd_Box bBox;
+    BRepBndLib::Add(face, bBox);
+    bBox.SetGap(0.0);
+    std::vector<TopoDS_Edge> candidates = makeEdgeOverlay(hl, bBox, scale);   //completely cover face bbox with lines
+
+    BRep_Builder builder;
+    TopoDS_Compound grid;
+    builder.MakeCompound(grid);
+    for (auto& c: candidates) {
+       builder.Add(grid, c);
+    }
+
+    BRepAlgoAPI_Common mkCommon(face, grid);
+    if ((!mkCommon.IsDone())  ||
+        (mkCommon.Shape().IsNull()) ) {
+        Base::Console().Log("INFO - DGH::clipHatchLinesBoolean - Common creation failed\n");
+        return result;
+    }
+
+    TopTools_IndexedMapOfShape mapOfEdges;
+    TopExp::MapShapes(mkCommon.Shape(), TopAbs_EDGE, mapOfEdges);
+    for (int i = 1 ; i <= mapOfEdges.Extent() ; i++) {
+        const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
+        if (!edge.IsNull()) {
+            result.push_back(edge);
+        }
+    }
+    return result;
+}
+
 TopoDS_Edge DrawGeomHatch::makeLine(Base::Vector3d s, Base::Vector3d e)
 {
     TopoDS_Edge result;
@@ -444,6 +663,28 @@ TopoDS_Edge DrawGeomHatch::makeLine(Base::Vector3d s, Base::Vector3d e)
     return result;
 }
 
+//! get the hatch lines of all line sets trimmed to a face in the XY plane,
+//! either by clipHatchLines or by the boolean reference method
+std::vector<TopoDS_Edge> DrawGeomHatch::getTrimmedEdges(const TopoDS_Face& face, bool useBoolean)
+{
+    std::vector<TopoDS_Edge> result;
+    std::vector<std::vector<Base::Vector3d> > polygons;
+    if (!useBoolean) {
+        polygons = getBoundaryPolygons(face);
+    }
+    for (auto& ls: m_lineSets) {
+        PATLineSpec hl = ls.getPATLineSpec();
+        std::vector<TopoDS_Edge> edges;
+        if (useBoolean) {
+            edges = clipHatchLinesBoolean(hl, face, ScalePattern.getValue());
+        } else {
+            edges = clipHatchLines(hl, polygons, ScalePattern.getValue());
+        }
+        result.insert(result.end(), edges.begin(), edges.end());
+    }
+    return result;
+}
+
 //! get all the untrimmed hatchlines for a face
 //! these will be clipped to shape on the gui side
 std::vector<LineSet> DrawGeomHatch::getFaceOverlay(int fdx)
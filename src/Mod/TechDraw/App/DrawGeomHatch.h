@@ -74,6 +74,8 @@ public:
 
     std::vector<LineSet> getFaceOverlay(int i = 0);
     std::vector<LineSet> getTrimmedLines(int i = 0);
+    std::vector<std::vector<LineSet> > getTrimmedLines(const std::vector<int>& faces);
+    std::vector<TopoDS_Edge> getTrimmedEdges(const TopoDS_Face& face, bool useBoolean = false);
     static std::vector<LineSet> getTrimmedLines(DrawViewPart* dvp, std::vector<LineSet> lineSets, int iface, double scale);
     static std::vector<LineSet> getTrimmedLines(DrawViewPart* source,
                                                 std::vector<LineSet> lineSets,
@@ -85,6 +87,13 @@ public:
                                                                 double scale );
 
     static std::vector<TopoDS_Edge> makeEdgeOverlay(PATLineSpec hl, Bnd_Box bBox, double scale);
+    static std::vector<std::vector<Base::Vector3d> > getBoundaryPolygons(const TopoDS_Face& face);
+    static std::vector<TopoDS_Edge> clipHatchLines(PATLineSpec hl,
+                                                   const std::vector<std::vector<Base::Vector3d> >& polygons,
+                                                   double scale);
+    static std::vector<TopoDS_Edge> clipHatchLinesBoolean(PATLineSpec hl,
+                                                          const TopoDS_Face& face,
+                                                          double scale);
     static TopoDS_Edge makeLine(Base::Vector3d s, Base::Vector3d e);
     static std::vector<PATLineSpec> getDecodedSpecsFromFile(std::string fileSpec, std::string myPattern);
     static TopoDS_Face extractFace(DrawViewPart* source, int iface );
@@ -1,6 +1,13 @@
 
 #include "PreCompiled.h"
 
+#include <TopoDS.hxx>
+
+#include <Mod/Part/App/OCCError.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeEdgePy.h>
+#include <Mod/Part/App/TopoShapeFacePy.h>
+
 #include "DrawGeomHatch.h"
 
 // inclusion of the generated files (generated out of DrawGeomHatchPy.xml)
@@ -15,6 +22,35 @@ std::string DrawGeomHatchPy::representation(void) const
     return std::string("<DrawGeomHatch object>");
 }
 
+PyObject* DrawGeomHatchPy::getTrimmedEdges(PyObject *args)
+{
+    PyObject* pFace;
+    PyObject* pBoolean = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(Part::TopoShapeFacePy::Type), &pFace,
+                                          &PyBool_Type, &pBoolean)) {
+        return nullptr;
+    }
+
+    const TopoDS_Shape& shape = static_cast<Part::TopoShapeFacePy*>(pFace)->getTopoShapePtr()->getShape();
+    std::vector<TopoDS_Edge> edges;
+    try {
+        edges = getDrawGeomHatchPtr()->getTrimmedEdges(TopoDS::Face(shape),
+                                                       PyObject_IsTrue(pBoolean) ? true : false);
+    }
+    catch (Standard_Failure& e) {
+        PyErr_SetString(Part::PartExceptionOCCError, e.GetMessageString());
+        return nullptr;
+    }
+
+    PyObject* pEdgeList = PyList_New(0);
+    for (auto& e: edges) {
+        PyObject* pEdge = new Part::TopoShapeEdgePy(new Part::TopoShape(e));
+        PyList_Append(pEdgeList, pEdge);
+        Py_DECREF(pEdge);
+    }
+    return pEdgeList;
+}
+
 
 
 
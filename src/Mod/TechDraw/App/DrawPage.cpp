@@ -347,8 +347,18 @@ void DrawPage::updateAllViews()
 //    Base::Console().Message("DP::updateAllViews()\n");
     std::vector<App::DocumentObject*> featViews = getAllViews();
     std::vector<App::DocumentObject*>::iterator it = featViews.begin();
-    //first, make sure all the Parts have been executed so GeometryObjects exist
+    //project all the Parts at once
+    std::vector<TechDraw::DrawViewPart*> parts;
     for(; it != featViews.end(); ++it) {
+        TechDraw::DrawViewPart *part = dynamic_cast<TechDraw::DrawViewPart *>(*it);
+        if (part != nullptr) {
+            parts.push_back(part);
+        }
+    }
+    TechDraw::DrawViewPart::prepareProjections(parts);
+
+    //first, make sure all the Parts have been executed so GeometryObjects exist
+    for(it = featViews.begin(); it != featViews.end(); ++it) {
         TechDraw::DrawViewPart *part = dynamic_cast<TechDraw::DrawViewPart *>(*it);
         TechDraw::DrawViewCollection *collect = dynamic_cast<TechDraw::DrawViewCollection*>(*it);
         if (part != nullptr) {
@@ -973,6 +973,12 @@ void DrawProjGroup::makeViewBbs(DrawProjGroupItem *viewPtrs[10],
 void DrawProjGroup::recomputeChildren(void)
 {
 //    Base::Console().Message("DPG::recomputeChildren()\n");
+    std::vector<DrawViewPart*> parts;
+    for( const auto it : Views.getValues() ) {
+        parts.push_back(dynamic_cast<DrawViewPart*>(it));
+    }
+    DrawViewPart::prepareProjections(parts);
+
     for( const auto it : Views.getValues() ) {
         auto view( dynamic_cast<DrawProjGroupItem *>(it) );
         if (view == nullptr) {
@@ -67,6 +67,8 @@
 #include <cmath>
 #include <GeomLib_Tool.hxx>
 
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <Base/BoundBox.h>
 #include <Base/Console.h>
@@ -170,68 +172,19 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
+    return splitEdgesAtVertices(faceEdges);
+}
 
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+//! split the edges where an end vertex of another edge lies on them and
+//! drop the duplicates this leaves where edges overlap.
+std::vector<TopoDS_Edge> DrawProjectSplit::splitEdgesAtVertices(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<splitPoint> splits = findSplits(edges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
     sorted.erase(last, sorted.end());                         //remove dupls
-    std::vector<TopoDS_Edge> newEdges = splitEdges(faceEdges,sorted);
+    std::vector<TopoDS_Edge> newEdges = splitEdges(edges,sorted);
 
     if (newEdges.empty()) {
         Base::Console().Log("LOG - DPS::extractFaces - no newEdges\n");
@@ -241,6 +194,86 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+//! find the points where an end vertex of one edge lies on another edge.
+//! Only edges with overlapping bounding boxes are compared: the boxes are
+//! swept along X to find the candidate pairs, which are then checked in parallel.
+std::vector<splitPoint> DrawProjectSplit::findSplits(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<Bnd_Box> boxes(edges.size());
+    std::vector<double> xMin(edges.size());
+    std::vector<double> xMax(edges.size());
+    std::vector<int> valid(edges.size(), 0);
+    std::vector<int> indices(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        indices[i] = i;
+    }
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        if (DrawUtil::isZeroEdge(edges[i])) {
+            return;  //skip zero length edges. shouldn't happen ;)
+        }
+        BRepBndLib::Add(edges[i], boxes[i]);
+        boxes[i].SetGap(0.1);
+        valid[i] = !boxes[i].IsVoid();
+        if (valid[i]) {
+            double y, z;
+            boxes[i].Get(xMin[i], y, z, xMax[i], y, z);
+        }
+    });
+
+    std::vector<int> order;
+    for (auto& i: indices) {
+        if (valid[i]) {
+            order.push_back(i);
+        } else {
+            Base::Console().Log("INFO - DPS::findSplits - edge: %d has no Bnd_Box\n", i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&xMin](int a, int b) {
+        return xMin[a] < xMin[b];
+    });
+
+    //the test is not symmetric (vertices of one edge on the other), so keep
+    //the candidates for both edges of a pair
+    std::vector<std::vector<int> > candidates(edges.size());
+    for (auto itOuter = order.begin(); itOuter != order.end(); ++itOuter) {
+        for (auto itInner = itOuter + 1; itInner != order.end(); ++itInner) {
+            if (xMin[*itInner] > xMax[*itOuter]) {
+                break;      //no more boxes overlapping in X
+            }
+            if (boxes[*itOuter].IsOut(boxes[*itInner])) {
+                continue;
+            }
+            candidates[*itOuter].push_back(*itInner);
+            candidates[*itInner].push_back(*itOuter);
+        }
+    }
+
+    std::vector<std::vector<splitPoint> > edgeSplits(edges.size());
+    QtConcurrent::blockingMap(order, [&](int iOuter) {
+        TopoDS_Vertex v1 = TopExp::FirstVertex(edges[iOuter]);
+        TopoDS_Vertex v2 = TopExp::LastVertex(edges[iOuter]);
+        for (auto& iInner: candidates[iOuter]) {
+            for (auto& v: { v1, v2 }) {
+                double param = -1;
+                if (isOnEdge(edges[iInner],v,param,false)) {
+                    gp_Pnt pnt = BRep_Tool::Pnt(v);
+                    splitPoint s;
+                    s.i = iInner;
+                    s.v = Base::Vector3d(pnt.X(),pnt.Y(),pnt.Z());
+                    s.param = param;
+                    edgeSplits[iOuter].push_back(s);
+                }
+            }
+        }
+    });
+
+    std::vector<splitPoint> result;
+    for (auto& s: edgeSplits) {
+        result.insert(result.end(), s.begin(), s.end());
+    }
+    return result;
+}
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
@@ -44,6 +44,7 @@
 #include <BRepLProp_CurveTool.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
+#include <BRepTools_ShapeSet.hxx>
 #include <GeomAPI_ProjectPointOnCurve.hxx>
 #include <Geom_Curve.hxx>
 #include <GeomLib_Tool.hxx>
@@ -54,6 +55,7 @@
 #include <GProp_GProps.hxx>
 #include <gp_XYZ.hxx>
 #include <HLRAlgo_Projector.hxx>
+#include <Precision.hxx>
 #include <HLRBRep_Algo.hxx>
 #include <HLRBRep_HLRToShape.hxx>
 #include <HLRBRep_ShapeBounds.hxx>
@@ -69,6 +71,8 @@
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <BRepAlgo_NormalProjection.hxx>
 
 #include <TopTools_IndexedMapOfShape.hxx>
@@ -77,7 +81,11 @@
 
 #include <limits>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+
+#include <QtConcurrentMap>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -97,6 +105,7 @@
 #include "DrawGeomHatch.h"
 #include "DrawHatch.h"
 #include "DrawPage.h"
+#include "DrawProjGroupItem.h"
 #include "DrawProjectSplit.h"
 #include "DrawUtil.h"
 #include "DrawViewBalloon.h"
@@ -168,6 +177,20 @@ DrawViewPart::DrawViewPart(void) :
     ADD_PROPERTY_TYPE(IsoHidden ,(prefIsoHid()),sgroup,App::Prop_None,"Show Hidden Iso u,v lines");
     ADD_PROPERTY_TYPE(IsoCount ,(prefIsoCount()),sgroup,App::Prop_None,"Number of iso parameters lines");
 
+    //result of the last hidden line removal, saved with the document
+    ADD_PROPERTY_TYPE(HLRCache ,(TopoDS_Shape()),sgroup,
+                      (App::PropertyType)(App::Prop_Output|App::Prop_Hidden),
+                      "Projected edges of the last hidden line removal");
+    ADD_PROPERTY_TYPE(HLRCacheKey ,(""),sgroup,
+                      (App::PropertyType)(App::Prop_Output|App::Prop_Hidden),
+                      "Source shape and projection parameters of HLRCache");
+    ADD_PROPERTY_TYPE(FaceCache ,(TopoDS_Shape()),sgroup,
+                      (App::PropertyType)(App::Prop_Output|App::Prop_Hidden),
+                      "Face wires found in the projected edges by the last execute");
+    ADD_PROPERTY_TYPE(FaceCacheKey ,(""),sgroup,
+                      (App::PropertyType)(App::Prop_Output|App::Prop_Hidden),
+                      "Projected edges FaceCache was made from");
+
     geometryObject = nullptr;
     getRunControl();
     //initialize bbox to non-garbage
@@ -266,7 +289,14 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
         return App::DocumentObject::StdReturn;
     }
 
-    TopoDS_Shape shape = getSourceShape();
+    if (m_pendingProjection && m_pendingProjection->sourceKeys != getSourceKeys()) {
+        m_pendingProjection.reset();
+    }
+    if (!m_pendingProjection) {
+        prepareSiblingProjections();
+    }
+
+    TopoDS_Shape shape = m_pendingProjection ? m_pendingProjection->sourceShape : getSourceShape();
     if (shape.IsNull()) {
         if (isRestoring) {
             Base::Console().Warning("DVP::execute - source shape is invalid - (but document is restoring) - %s\n",
@@ -356,7 +386,22 @@ void DrawViewPart::partExec(TopoDS_Shape shape)
 #if MOD_TECHDRAW_HANDLE_FACES
     if (handleFaces() && !geometryObject->usePolygonHLR()) {
         try {
-            extractFaces();
+            //the faces only depend on the projected edges used for them
+            std::string faceKey = HLRCacheKey.getStrValue() + ' ' +
+                                  (SmoothVisible.getValue() ? '1' : '0') +
+                                  (SeamVisible.getValue() ? '1' : '0');
+            std::vector<TopoDS_Wire> faceWires;
+            if (faceKey == FaceCacheKey.getStrValue()) {
+                TopoDS_Iterator it(FaceCache.getValue());
+                for (; it.More(); it.Next()) {
+                    faceWires.push_back(TopoDS::Wire(it.Value()));
+                }
+            } else {
+                faceWires = findFaceWires();
+                setFaceCache(faceKey, faceWires);
+            }
+            geometryObject->clearFaceGeom();
+            addFaces(faceWires);
         }
         catch (Standard_Failure& e4) {
             Base::Console().Log("LOG - DVP::partExec - extractFaces failed for %s - %s **\n",getNameInDocument(),e4.GetMessageString());
@@ -401,45 +446,295 @@ void DrawViewPart::addShapes2d(void)
     }
 }
 
-GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
+//! result of a hidden line removal done in advance by prepareProjections().
+//! If the saved HLRCache is still valid there is no new result (go is null),
+//! only the validated cacheKey is kept so execute() does not need to compute
+//! it again.
+struct DrawViewPart::PendingProjection {
+    std::vector<TopoDS_Shape> sourceKeys;
+    TopoDS_Shape sourceShape;
+    gp_Ax2 viewAxis;
+    double scale = 0.0;
+    double rotation = 0.0;
+    bool perspective = false;
+    double focus = 0.0;
+    long isoCount = 0;
+    bool coarse = false;
+    Base::Vector3d centroid;
+    TopoDS_Shape centeredShape;
+    TopoDS_Shape scaledShape;
+    std::string cacheKey;
+    TechDraw::GeometryObject* go = nullptr;
+
+    ~PendingProjection() {
+        delete go;
+    }
+
+    bool matches(DrawViewPart* dvp, const gp_Ax2& axis) const {
+        return axis.Location().IsEqual(viewAxis.Location(), Precision::Confusion()) &&
+               axis.Direction().IsEqual(viewAxis.Direction(), Precision::Angular()) &&
+               axis.XDirection().IsEqual(viewAxis.XDirection(), Precision::Angular()) &&
+               DrawUtil::fpCompare(dvp->getScale(), scale) &&
+               DrawUtil::fpCompare(dvp->Rotation.getValue(), rotation) &&
+               dvp->Perspective.getValue() == perspective &&
+               DrawUtil::fpCompare(dvp->Focus.getValue(), focus) &&
+               dvp->IsoCount.getValue() == isoCount &&
+               dvp->CoarseView.getValue() == coarse;
+    }
+};
+
+//! identify the source shapes without copying them (see ShapeExtractor::getShapes)
+std::vector<TopoDS_Shape> DrawViewPart::getSourceKeys(void) const
 {
-    gp_Pnt inputCenter;
-    Base::Vector3d stdOrg(0.0,0.0,0.0);
+    std::vector<TopoDS_Shape> result;
+    for (auto& l: getAllSources()) {
+        result.push_back(Part::Feature::getShape(l));
+    }
+    return result;
+}
 
-    gp_Ax2 viewAxis = getProjectionCS(stdOrg);
+void DrawViewPart::prepareProjections(const std::vector<DrawViewPart*>& views)
+{
+    std::vector<PendingProjection*> jobs;
+    for (auto& dvp: views) {
+        //derived views like sections build their geometry differently
+        if ((dvp == nullptr) ||
+            ((dvp->getTypeId() != DrawViewPart::getClassTypeId()) &&
+             (dvp->getTypeId() != DrawProjGroupItem::getClassTypeId())) ||
+            !dvp->keepUpdated() ||
+            dvp->getAllSources().empty()) {
+            continue;
+        }
+        std::vector<TopoDS_Shape> sourceKeys = dvp->getSourceKeys();
+        if (dvp->m_pendingProjection &&
+            dvp->m_pendingProjection->sourceKeys == sourceKeys) {
+            continue;
+        }
+        std::unique_ptr<PendingProjection> pending(new PendingProjection);
+        pending->sourceKeys = sourceKeys;
+        pending->sourceShape = dvp->getSourceShape();
+        if (pending->sourceShape.IsNull()) {
+            continue;
+        }
+        pending->viewAxis = dvp->getProjectionCS(Base::Vector3d(0.0,0.0,0.0));
+        pending->scale = dvp->getScale();
+        pending->rotation = dvp->Rotation.getValue();
+        pending->perspective = dvp->Perspective.getValue();
+        pending->focus = dvp->Focus.getValue();
+        pending->isoCount = dvp->IsoCount.getValue();
+        pending->coarse = dvp->CoarseView.getValue();
+        pending->cacheKey = dvp->getHLRCacheKey(pending->sourceShape, pending->viewAxis);
+        if (pending->cacheKey == dvp->HLRCacheKey.getStrValue()) {
+            //makeGeometryForShape will take the saved result. Keep the checked
+            //key, so the view is not prepared again by its siblings.
+            dvp->m_pendingProjection = std::move(pending);
+            continue;
+        }
+        dvp->prepareShape(pending->sourceShape,
+                          pending->viewAxis,
+                          pending->centroid,
+                          pending->centeredShape,
+                          pending->scaledShape);
+        pending->go = dvp->newGeometryObject();
+        //Base::Console() is not used from the worker threads
+        pending->go->deferMessages(true);
+        if (pending->go->usePolygonHLR()) {
+            //the polygon algorithm meshes the faces. At scale 1 without rotation
+            //only the location changes, so the faces would still be shared with
+            //the source shape and with every other view of it.
+            pending->scaledShape = BRepBuilderAPI_Copy(pending->scaledShape).Shape();
+        }
+        jobs.push_back(pending.get());
+        dvp->m_pendingProjection = std::move(pending);
+    }
 
-    inputCenter = TechDraw::findCentroid(shape,
-                                         viewAxis);
-    Base::Vector3d centroid(inputCenter.X(),
-                            inputCenter.Y(),
-                            inputCenter.Z());
+    //the hidden line removal only works on the given shapes, so can be run in
+    //parallel. Everything touching the document is done above or in execute().
+    QtConcurrent::blockingMap(jobs, [](PendingProjection* pending) {
+        if (pending->go->usePolygonHLR()){
+            pending->go->projectShapeWithPolygonAlgo(pending->scaledShape,
+                pending->viewAxis);
+        }
+        else{
+            pending->go->projectShape(pending->scaledShape,
+                pending->viewAxis);
+        }
+    });
+}
+
+//! project all views waiting for recompute together with this one, if their
+//! sources are already up to date.
+void DrawViewPart::prepareSiblingProjections(void)
+{
+    std::vector<DrawViewPart*> views;
+    views.push_back(this);
+    for (auto& obj: getDocument()->getObjectsOfType(DrawViewPart::getClassTypeId())) {
+        auto dvp = static_cast<DrawViewPart*>(obj);
+        if ((dvp == this) ||
+            dvp->m_pendingProjection ||
+            !(dvp->isTouched() || dvp->mustExecute())) {
+            continue;
+        }
+        bool ready = true;
+        for (auto& l: dvp->getAllSources()) {
+            if (l->isTouched() || l->mustExecute()) {
+                ready = false;
+                break;
+            }
+        }
+        if (ready) {
+            views.push_back(dvp);
+        }
+    }
+    if (views.size() > 1) {
+        prepareProjections(views);
+    }
+}
+
+void DrawViewPart::prepareShape(const TopoDS_Shape& shape, const gp_Ax2& viewAxis,
+                                Base::Vector3d& centroid, TopoDS_Shape& centeredShape,
+                                TopoDS_Shape& scaledShape)
+{
+    gp_Pnt inputCenter = TechDraw::findCentroid(shape,
+                                                viewAxis);
+    centroid = Base::Vector3d(inputCenter.X(),
+                              inputCenter.Y(),
+                              inputCenter.Z());
 
     //center shape on origin
-    TopoDS_Shape centeredShape = TechDraw::moveShape(shape,
-                                                     centroid * -1.0);
-    m_saveCentroid = centroid;
-    m_saveShape = centeredShape;
+    centeredShape = TechDraw::moveShape(shape,
+                                        centroid * -1.0);
 
-    TopoDS_Shape scaledShape = TechDraw::scaleShape(centeredShape,
-                                                    getScale());
+    scaledShape = TechDraw::scaleShape(centeredShape,
+                                       getScale());
     if (!DrawUtil::fpCompare(Rotation.getValue(),0.0)) {
         scaledShape = TechDraw::rotateShape(scaledShape,
                                             viewAxis,
                                             Rotation.getValue());  //conventional rotation
      }
+}
+
+GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
+{
+    Base::Vector3d stdOrg(0.0,0.0,0.0);
+
+    gp_Ax2 viewAxis = getProjectionCS(stdOrg);
+
+    std::unique_ptr<PendingProjection> pending(std::move(m_pendingProjection));
+    if (pending && !pending->matches(this, viewAxis)) {
+        pending.reset();
+    }
+    if (pending && pending->go) {
+        m_saveCentroid = pending->centroid;
+        m_saveShape = pending->centeredShape;
+        GeometryObject* go = pending->go;
+        pending->go = nullptr;
+        go->flushMessages();
+        go->deferMessages(false);
+        setHLRCache(pending->cacheKey, go);
+        finishGeometryObject(go);
+        return go;
+    }
+
+    Base::Vector3d centroid;
+    TopoDS_Shape centeredShape;
+    TopoDS_Shape scaledShape;
+    prepareShape(shape, viewAxis, centroid, centeredShape, scaledShape);
+    m_saveCentroid = centroid;
+    m_saveShape = centeredShape;
+
+    std::string cacheKey = pending ? pending->cacheKey : getHLRCacheKey(shape, viewAxis);
+    if (cacheKey == HLRCacheKey.getStrValue()) {
+        //only the projected edges are cached, the faces are still extracted by partExec()
+        GeometryObject* go = newGeometryObject();
+        go->setHLRResult(HLRCache.getValue());
+        finishGeometryObject(go);
+        return go;
+    }
+
 //    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
     GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
+    setHLRCache(cacheKey, go);
     return go;
 }
 
-//note: slightly different than routine with same name in DrawProjectSplit
-TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
+//! fingerprint of the geometry of a shape. Unlike the TShape pointers used by
+//! getSourceKeys() this survives saving and reopening the document.
+static std::string shapeFingerprint(const TopoDS_Shape& shape)
+{
+    //the BRep text holds all curves and surfaces (e.g. the poles of b-splines),
+    //the topology and locations. Triangulations are left out, they depend on
+    //whether the shape has been displayed.
+    std::ostringstream brep;
+    BRepTools_ShapeSet shapeSet(Standard_False);
+    shapeSet.Add(shape);
+    shapeSet.Write(brep);
+    shapeSet.Write(shape, brep);
+
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : brep.str()) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    std::ostringstream ss;
+    ss << std::hex << hash;
+    return ss.str();
+}
+
+//! identify the result of a hidden line removal of shape by everything it depends on
+std::string DrawViewPart::getHLRCacheKey(const TopoDS_Shape& shape, const gp_Ax2& viewAxis) const
+{
+    auto writeDir = [](std::ostream& s, const gp_XYZ& v) {
+        s << v.X() << ',' << v.Y() << ',' << v.Z() << ' ';
+    };
+    std::ostringstream ss;
+    ss.precision(12);
+    ss << shapeFingerprint(shape) << ' ';
+    writeDir(ss, viewAxis.Location().XYZ());
+    writeDir(ss, viewAxis.Direction().XYZ());
+    writeDir(ss, viewAxis.XDirection().XYZ());
+    ss << getScale() << ' '
+       << Rotation.getValue() << ' '
+       << (Perspective.getValue() ? Focus.getValue() : 0.0) << ' '
+       << IsoCount.getValue() << ' '
+       << (CoarseView.getValue() ? "coarse" : "exact");
+    return ss.str();
+}
+
+void DrawViewPart::setHLRCache(const std::string& key, TechDraw::GeometryObject* go)
+{
+    HLRCache.setValue(go->getHLRResult());
+    HLRCacheKey.setValue(key);
+}
+
+void DrawViewPart::setFaceCache(const std::string& key, const std::vector<TopoDS_Wire>& faceWires)
+{
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (auto& w: faceWires) {
+        builder.Add(comp, w);
+    }
+    FaceCache.setValue(comp);
+    FaceCacheKey.setValue(key);
+}
+
+TechDraw::GeometryObject* DrawViewPart::newGeometryObject(void)
 {
     TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
     go->setIsoCount(IsoCount.getValue());
     go->isPerspective(Perspective.getValue());
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
+    return go;
+}
+
+//note: slightly different than routine with same name in DrawProjectSplit
+TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
+{
+    TechDraw::GeometryObject* go = newGeometryObject();
 
     if (go->usePolygonHLR()){
         go->projectShapeWithPolygonAlgo(shape,
@@ -450,6 +745,13 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
             viewAxis);
     }
 
+    finishGeometryObject(go);
+    return go;
+}
+
+//! extract the edges selected by the view properties from the projected shape
+void DrawViewPart::finishGeometryObject(TechDraw::GeometryObject* go)
+{
     go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
                         true);
     go->extractGeometry(TechDraw::ecOUTLINE,
@@ -490,7 +792,6 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
         Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
     }
     bbox = go->calcBoundingBox();
-    return go;
 }
 
 //! make faces from the existing edge geometry
@@ -500,6 +801,16 @@ void DrawViewPart::extractFaces()
         return;
     }
     geometryObject->clearFaceGeom();
+    addFaces(findFaceWires());
+}
+
+//! find the outer wires of the faces bounded by the existing edge geometry
+std::vector<TopoDS_Wire> DrawViewPart::findFaceWires()
+{
+    std::vector<TopoDS_Wire> result;
+    if (geometryObject == nullptr) {
+        return result;
+    }
     const std::vector<TechDraw::BaseGeom*>& goEdges =
                        geometryObject->getVisibleFaceEdges(SmoothVisible.getValue(),SeamVisible.getValue());
     std::vector<TechDraw::BaseGeom*>::const_iterator itEdge = goEdges.begin();
@@ -520,63 +831,12 @@ void DrawViewPart::extractFaces()
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplits(nonZero);
+    auto end   = std::chrono::high_resolution_clock::now();
+    double diffOut = std::chrono::duration <double, std::milli> (end - start).count();
+    Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs splitting %d edges\n",
+                        getNameInDocument(), diffOut, (int) nonZero.size());
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -585,7 +845,7 @@ void DrawViewPart::extractFaces()
 
     if (newEdges.empty()) {
         Base::Console().Log("DVP::extractFaces - no newEdges\n");
-        return;
+        return result;
     }
 
     newEdges = DrawProjectSplit::removeDuplicateEdges(newEdges);        //<<< here
@@ -596,14 +856,19 @@ void DrawViewPart::extractFaces()
     bool success = ew.perform();
     if (!success) {
         Base::Console().Warning("DVP::extractFaces - %s -Can't make faces from projected edges\n", getNameInDocument());
-        return;
+        return result;
     }
     std::vector<TopoDS_Wire> fw = ew.getResultNoDups();
 
-    std::vector<TopoDS_Wire> sortedWires = ew.sortStrip(fw,true);
+    result = ew.sortStrip(fw,true);
+    return result;
+}
 
+//! add one face to the geometry for each wire
+void DrawViewPart::addFaces(const std::vector<TopoDS_Wire>& sortedWires)
+{
 //    int idb = 0;
-    std::vector<TopoDS_Wire>::iterator itWire = sortedWires.begin();
+    std::vector<TopoDS_Wire>::const_iterator itWire = sortedWires.begin();
     for (; itWire != sortedWires.end(); itWire++) {
         //version 1: 1 wire/face - no voids in face
 //debug
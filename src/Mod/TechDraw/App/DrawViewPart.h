@@ -35,8 +35,12 @@
 #include <App/PropertyUnits.h>
 #include <App/FeaturePython.h>
 
+#include <Mod/Part/App/PropertyTopoShape.h>
+
 #include <Base/BoundBox.h>
 
+#include <memory>
+
 #include "PropertyGeomFormatList.h"
 #include "PropertyCenterLineList.h"
 #include "PropertyCosmeticEdgeList.h"
@@ -112,6 +116,11 @@ public:
     App::PropertyBool   IsoHidden;
     App::PropertyInteger  IsoCount;
 
+    Part::PropertyPartShape HLRCache;
+    App::PropertyString     HLRCacheKey;
+    Part::PropertyPartShape FaceCache;
+    App::PropertyString     FaceCacheKey;
+
     virtual short mustExecute() const override;
     virtual void onDocumentRestored() override;
     virtual App::DocumentObjectExecReturn *execute(void) override;
@@ -206,6 +215,13 @@ public:
 
     std::vector<App::DocumentObject*> getAllSources(void) const;
 
+    /** Run the hidden line removal of the given views concurrently
+     *
+     * The result is kept by each view, and used by its next execute() as long
+     * as the source shapes and projection parameters are unchanged.
+     */
+    static void prepareProjections(const std::vector<DrawViewPart*> &views);
+
 
 protected:
     bool checkXDirection(void) const;
@@ -222,6 +238,23 @@ protected:
     virtual void addShapes2d(void);
 
     void extractFaces();
+    std::vector<TopoDS_Wire> findFaceWires();
+    void addFaces(const std::vector<TopoDS_Wire> &sortedWires);
+
+    void prepareShape(const TopoDS_Shape &shape, const gp_Ax2 &viewAxis,
+                      Base::Vector3d &centroid, TopoDS_Shape &centeredShape,
+                      TopoDS_Shape &scaledShape);
+    TechDraw::GeometryObject* newGeometryObject(void);
+    void finishGeometryObject(TechDraw::GeometryObject *go);
+
+    struct PendingProjection;
+    std::unique_ptr<PendingProjection> m_pendingProjection;
+    std::vector<TopoDS_Shape> getSourceKeys(void) const;
+    void prepareSiblingProjections(void);
+
+    std::string getHLRCacheKey(const TopoDS_Shape &shape, const gp_Ax2 &viewAxis) const;
+    void setHLRCache(const std::string &key, TechDraw::GeometryObject *go);
+    void setFaceCache(const std::string &key, const std::vector<TopoDS_Wire> &faceWires);
 
     Base::Vector3d shapeCentroid;
     void getRunControl(void);
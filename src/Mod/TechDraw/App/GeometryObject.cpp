@@ -56,6 +56,8 @@
 #include <TopLoc_Location.hxx>
 
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
@@ -68,6 +70,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdarg>
+#include <cstdio>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -95,7 +99,8 @@ GeometryObject::GeometryObject(const string& parent, TechDraw::DrawView* parentO
     m_isoCount(0),
     m_isPersp(false),
     m_focus(100.0),
-    m_usePolygonHLR(false)
+    m_usePolygonHLR(false),
+    m_deferMessages(false)
 
 {
 }
@@ -170,6 +175,47 @@ void GeometryObject::clear()
     edgeGeom.clear();
 }
 
+//! send a console message now or keep it for flushMessages()
+void GeometryObject::report(MessageType type, const char* format, ...)
+{
+    char buffer[1024];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (m_deferMessages) {
+        m_messages.emplace_back(type, buffer);
+        return;
+    }
+    switch (type) {
+        case Base::ConsoleSingleton::MsgType_Err:
+            Base::Console().Error("%s", buffer);
+            break;
+        case Base::ConsoleSingleton::MsgType_Wrn:
+            Base::Console().Warning("%s", buffer);
+            break;
+        case Base::ConsoleSingleton::MsgType_Log:
+            Base::Console().Log("%s", buffer);
+            break;
+        default:
+            Base::Console().Message("%s", buffer);
+            break;
+    }
+}
+
+void GeometryObject::flushMessages(void)
+{
+    std::vector<std::pair<MessageType, std::string> > messages;
+    messages.swap(m_messages);
+    bool defer = m_deferMessages;
+    m_deferMessages = false;
+    for (auto& m: messages) {
+        report(m.first, "%s", m.second.c_str());
+    }
+    m_deferMessages = defer;
+}
+
 //!set up a hidden line remover and project a shape with it
 void GeometryObject::projectShape(const TopoDS_Shape& input,
                                   const gp_Ax2 viewAxis)
@@ -198,18 +244,19 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while projecting shape\n",
-                              e.GetMessageString());
+        report(Base::ConsoleSingleton::MsgType_Err,
+               "GO::projectShape - OCC error - %s - while projecting shape\n",
+               e.GetMessageString());
         }
     catch (...) {
-        Base::Console().Error("GeometryObject::projectShape - unknown error occurred while projecting shape\n");
+        report(Base::ConsoleSingleton::MsgType_Err, "GeometryObject::projectShape - unknown error occurred while projecting shape\n");
 //        throw Base::RuntimeError("GeometryObject::projectShape - unknown error occurred while projecting shape");
     }
 
     auto end   = chrono::high_resolution_clock::now();
     auto diff  = end - start;
     double diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_Algo & co\n",m_parentName.c_str(),diffOut);
+    report(Base::ConsoleSingleton::MsgType_Log, "TIMING - %s GO spent: %.3f millisecs in HLRBRep_Algo & co\n",m_parentName.c_str(),diffOut);
 
     start = chrono::high_resolution_clock::now();
 
@@ -260,17 +307,54 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while extracting edges\n",
-                              e.GetMessageString());
+        report(Base::ConsoleSingleton::MsgType_Err,
+               "GO::projectShape - OCC error - %s - while extracting edges\n",
+               e.GetMessageString());
     }
     catch (...) {
-        Base::Console().Error("GO::projectShape - unknown error while extracting edges\n");
+        report(Base::ConsoleSingleton::MsgType_Err, "GO::projectShape - unknown error while extracting edges\n");
 //        throw Base::RuntimeError("GeometryObject::projectShape - error occurred while extracting edges");
     }
     end   = chrono::high_resolution_clock::now();
     diff  = end - start;
     diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
+    report(Base::ConsoleSingleton::MsgType_Log, "TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
+}
+
+TopoDS_Shape GeometryObject::getHLRResult(void) const
+{
+    //null results are stored as empty compounds to keep the order
+    BRep_Builder builder;
+    TopoDS_Compound result;
+    builder.MakeCompound(result);
+    for (auto& s: { visHard, visOutline, visSmooth, visSeam, visIso,
+                    hidHard, hidOutline, hidSmooth, hidSeam, hidIso }) {
+        if (s.IsNull()) {
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(result, empty);
+        } else {
+            builder.Add(result, s);
+        }
+    }
+    return result;
+}
+
+void GeometryObject::setHLRResult(const TopoDS_Shape& result)
+{
+    clear();
+    std::vector<TopoDS_Shape*> targets = { &visHard, &visOutline, &visSmooth, &visSeam, &visIso,
+                                           &hidHard, &hidOutline, &hidSmooth, &hidSeam, &hidIso };
+    for (auto& t: targets) {
+        t->Nullify();
+    }
+    if (result.IsNull()) {
+        return;
+    }
+    auto target = targets.begin();
+    for (TopoDS_Iterator it(result); it.More() && (target != targets.end()); it.Next(), ++target) {
+        **target = it.Value();
+    }
 }
 
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
@@ -341,11 +425,12 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
         brep_hlrPoly->Update();
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShapeWithPolygonAlgo - OCC error - %s - while projecting shape\n",
-                              e.GetMessageString());
+        report(Base::ConsoleSingleton::MsgType_Err,
+               "GO::projectShapeWithPolygonAlgo - OCC error - %s - while projecting shape\n",
+               e.GetMessageString());
     }
     catch (...) {
-        Base::Console().Error("GO::projectShapeWithPolygonAlgo - unknown error while projecting shape\n");
+        report(Base::ConsoleSingleton::MsgType_Err, "GO::projectShapeWithPolygonAlgo - unknown error while projecting shape\n");
 //        throw Base::RuntimeError("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while projecting shape");
 //        Standard_Failure::Raise("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while projecting shape");
     }
@@ -389,18 +474,19 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
         hidOutline = invertGeometry(hidOutline);
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShapeWithPolygonAlgo - OCC error - %s - while extracting edges\n",
-                              e.GetMessageString());
+        report(Base::ConsoleSingleton::MsgType_Err,
+               "GO::projectShapeWithPolygonAlgo - OCC error - %s - while extracting edges\n",
+               e.GetMessageString());
     }
     catch (...) {
-        Base::Console().Error("GO::projectShapeWithPolygonAlgo - - error occurred while extracting edges\n");
+        report(Base::ConsoleSingleton::MsgType_Err, "GO::projectShapeWithPolygonAlgo - - error occurred while extracting edges\n");
 //        throw Base::RuntimeError("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while extracting edges");
 //        Standard_Failure::Raise("GeometryObject::projectShapeWithPolygonAlgo - error occurred while extracting edges");
     }
     auto end = chrono::high_resolution_clock::now();
     auto diff = end - start;
     double diffOut = chrono::duration <double, milli>(diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_PolyAlgo & co\n", m_parentName.c_str(), diffOut);
+    report(Base::ConsoleSingleton::MsgType_Log, "TIMING - %s GO spent: %.3f millisecs in HLRBRep_PolyAlgo & co\n", m_parentName.c_str(), diffOut);
 }
 
 TopoDS_Shape GeometryObject::projectFace(const TopoDS_Shape &face,
@@ -28,9 +28,11 @@
 #include <gp_Pnt.hxx>
 #include <gp_Ax2.hxx>
 
+#include <Base/Console.h>
 #include <Base/Vector3D.h>
 #include <Base/BoundBox.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Geometry.h"
@@ -128,6 +130,11 @@ public:
     bool isPerspective(void) { return m_isPersp; }
     void usePolygonHLR(bool b) { m_usePolygonHLR = b; }
     bool usePolygonHLR(void) const { return m_usePolygonHLR; }
+    //! keep the console messages of the projection instead of printing them,
+    //! for a projection run in a worker thread
+    void deferMessages(bool b) { m_deferMessages = b; }
+    //! print the kept messages, only call this from the main thread
+    void flushMessages(void);
     void setFocus(double f) { m_focus = f; }
     double getFocus(void) { return m_focus; }
     void pruneVertexGeom(Base::Vector3d center, double radius);
@@ -146,6 +153,11 @@ public:
     TopoDS_Shape getHidSeam(void)    { return hidSeam; }
     TopoDS_Shape getHidIso(void)     { return hidIso; }
 
+    //! all HLR output in one compound (for caching), see setHLRResult
+    TopoDS_Shape getHLRResult(void) const;
+    //! replace the HLR output with a compound from getHLRResult
+    void setHLRResult(const TopoDS_Shape& result);
+
     void addVertex(TechDraw::Vertex* v);
     void addEdge(TechDraw::BaseGeom* bg);
 
@@ -198,6 +210,11 @@ protected:
 
     bool findVertex(Base::Vector3d v);
 
+    typedef Base::ConsoleSingleton::FreeCAD_ConsoleMsgType MessageType;
+    void report(MessageType type, const char* format, ...);
+    std::vector<std::pair<MessageType, std::string> > m_messages;
+    bool m_deferMessages;
+
     std::string m_parentName;
     TechDraw::DrawView* m_parent;
     int m_isoCount;
@@ -471,6 +471,23 @@ void QGIViewPart::drawViewPart()
         std::vector<TechDraw::DrawHatch*> hatchObjs = viewPart->getHatches();
         std::vector<TechDraw::DrawGeomHatch*> geomObjs = viewPart->getGeomHatches();
         const std::vector<TechDraw::Face *> &faceGeoms = viewPart->getFaceGeometry();
+
+        //trim the hatch lines of all faces of a hatch together
+        std::map<TechDraw::DrawGeomHatch*, std::vector<int> > geomHatchFaces;
+        for (int i = 0; i < (int) faceGeoms.size(); i++) {
+            TechDraw::DrawGeomHatch* fGeom = faceIsGeomHatched(i,geomObjs);
+            if (fGeom && !fGeom->Source.getSubValues().empty()) {
+                geomHatchFaces[fGeom].push_back(i);
+            }
+        }
+        std::map<int, std::vector<LineSet> > trimmedLines;
+        for (auto& hf: geomHatchFaces) {
+            std::vector<std::vector<LineSet> > faceLines = hf.first->getTrimmedLines(hf.second);
+            for (size_t j = 0; j < hf.second.size(); j++) {
+                trimmedLines[hf.second[j]] = faceLines[j];
+            }
+        }
+
         std::vector<TechDraw::Face *>::const_iterator fit = faceGeoms.begin();
         for(int i = 0 ; fit != faceGeoms.end(); fit++, i++) {
             QGIFace* newFace = drawFace(*fit,i);
@@ -482,7 +499,7 @@ void QGIViewPart::drawViewPart()
             if (fGeom) {
                 const std::vector<std::string> &sourceNames = fGeom->Source.getSubValues();
                 if (!sourceNames.empty()) {
-                    std::vector<LineSet> lineSets = fGeom->getTrimmedLines(i);
+                    std::vector<LineSet> lineSets = trimmedLines[i];
                     if (!lineSets.empty()) {
                         newFace->clearLineSets();
                         for (auto& ls: lineSets) {
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# test script for TechDraw module
+# compares the hatch lines of a DrawGeomHatch trimmed by the scanline clipper
+# with those of the boolean method on faces with holes, arcs and b-splines
+from __future__ import print_function
+
+import FreeCAD
+import Part
+import Measure
+import TechDraw
+
+import os
+import tempfile
+
+patterns = """*Straight, horizontal and vertical lines
+0,0.3,0.3,0,2.7
+90,0.3,0.3,0,2.7
+*Oblique, lines at 30, 45 and -60 degrees
+30,0.3,0.3,0,2.3
+45,0.1,0.2,0,3.1
+-60,0.4,0.1,0,1.9
+"""
+
+def makeFaces():
+    faces = []
+    #rectangle with a rectangular hole
+    outer = Part.makePlane(40, 30)
+    hole = Part.makePlane(10, 10, FreeCAD.Vector(10, 10, 0))
+    faces.append(("hole", outer.cut(hole).Faces[0]))
+    #disc (arc boundary) with a rectangular hole
+    disc = Part.Face(Part.Wire(Part.makeCircle(12, FreeCAD.Vector(15, 15, 0))))
+    hole = Part.makePlane(6, 4, FreeCAD.Vector(12, 13, 0))
+    faces.append(("arc", disc.cut(hole).Faces[0]))
+    #closed b-spline
+    curve = Part.BSplineCurve()
+    curve.interpolate([FreeCAD.Vector(0, 0, 0), FreeCAD.Vector(20, -5, 0),
+                       FreeCAD.Vector(35, 10, 0), FreeCAD.Vector(20, 25, 0),
+                       FreeCAD.Vector(5, 18, 0)], PeriodicFlag=True)
+    faces.append(("bspline", Part.Face(Part.Wire(curve.toShape()))))
+    return faces
+
+def totalLength(edges):
+    return sum(e.Length for e in edges)
+
+def DGeomHatchTest():
+    path = os.path.dirname(os.path.abspath(__file__))
+    print ('TDGeomHatch path: ' + path)
+    patFileSpec = os.path.join(tempfile.gettempdir(), "TDGeomHatch.pat")
+    with open(patFileSpec, "w") as patFile:
+        patFile.write(patterns)
+
+    doc = FreeCAD.newDocument("TDGeomHatch")
+    FreeCAD.setActiveDocument("TDGeomHatch")
+
+    hatch = doc.addObject('TechDraw::DrawGeomHatch','GeomHatch')
+    hatch.FilePattern = patFileSpec
+
+    rc = True
+    for name in ["Straight", "Oblique"]:
+        hatch.NamePattern = name
+        doc.recompute()
+        for faceName, face in makeFaces():
+            clipped = hatch.getTrimmedEdges(face)
+            reference = hatch.getTrimmedEdges(face, True)
+            if not reference:
+                print("TDGeomHatch: {} {} - no reference lines".format(name, faceName))
+                rc = False
+                continue
+            if len(clipped) != len(reference):
+                print("TDGeomHatch: {} {} - {} segments, boolean has {}"
+                      .format(name, faceName, len(clipped), len(reference)))
+                rc = False
+            #curved boundaries are approximated by polygons
+            length = totalLength(clipped)
+            referenceLength = totalLength(reference)
+            if abs(length - referenceLength) > 0.005 * referenceLength:
+                print("TDGeomHatch: {} {} - length {}, boolean has {}"
+                      .format(name, faceName, length, referenceLength))
+                rc = False
+
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(patFileSpec)
+    return rc
+
+if __name__ == '__main__':
+    DGeomHatchTest()
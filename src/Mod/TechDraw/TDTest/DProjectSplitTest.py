@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# test script for TechDraw module
+# checks where projected edges are split by the end vertices of other edges,
+# for crossing, touching and overlapping edges
+from __future__ import print_function
+
+import FreeCAD
+import Part
+import Measure
+import TechDraw
+
+import os
+import random
+
+V = FreeCAD.Vector
+
+def line(x1, y1, x2, y2):
+    return Part.makeLine(V(x1, y1, 0), V(x2, y2, 0))
+
+def arc(p1, p2, p3):
+    return Part.Edge(Part.Arc(p1, p2, p3))
+
+def referenceCount(edges):
+    #split each edge at every distinct end vertex of another edge on its inside
+    tol = 1.0e-7
+    count = 0
+    for i, e in enumerate(edges):
+        ends = [v.Point for v in e.Vertexes]
+        points = []
+        for j, other in enumerate(edges):
+            if i == j:
+                continue
+            for v in other.Vertexes:
+                p = v.Point
+                if any((p - q).Length < tol for q in ends + points):
+                    continue
+                if e.distToShape(v)[0] < tol:
+                    points.append(p)
+        count += len(points) + 1
+    return count
+
+def totalLength(edges):
+    return sum(e.Length for e in edges)
+
+def check(name, edges, expectedCount, expectedLength):
+    result = TechDraw.splitEdgesAtVertices(edges)
+    rc = True
+    if len(result) != expectedCount:
+        print("TDProjectSplit: {} - {} edges, expected {}".format(name, len(result), expectedCount))
+        rc = False
+    if abs(totalLength(result) - expectedLength) > 1.0e-6:
+        print("TDProjectSplit: {} - length {}, expected {}".format(name, totalLength(result), expectedLength))
+        rc = False
+    return rc
+
+def makeGrid():
+    #vertical lines end on the bottom and top lines and cross the others
+    edges = [line(0, 5 * i, 50, 5 * i) for i in range(5)]
+    edges += [line(2.5 + 5 * i, 0, 2.5 + 5 * i, 20) for i in range(10)]
+    random.Random(0).shuffle(edges)
+    return edges
+
+def DProjectSplitTest():
+    path = os.path.dirname(os.path.abspath(__file__))
+    print ('TDProjectSplit path: ' + path)
+
+    rc = True
+    #crossing inside both edges: nothing to split
+    rc = check("cross", [line(0, 0, 10, 10), line(0, 10, 10, 0)], 2, 2 * 200 ** 0.5) and rc
+    #end of one edge on the inside of the other
+    rc = check("tee", [line(0, 0, 10, 0), line(5, 0, 5, 5)], 3, 15) and rc
+    #collinear edges overlapping between 5 and 10, which is kept once
+    rc = check("overlap", [line(0, 0, 10, 0), line(5, 0, 15, 0)], 3, 15) and rc
+    #one edge inside another
+    rc = check("contained", [line(0, 0, 20, 0), line(5, 0, 10, 0)], 3, 20) and rc
+    #arc ending on a line, line ending on the arc
+    edges = [line(0, 0, 20, 0), arc(V(10, 0, 0), V(15, 5, 0), V(20, 0, 0)),
+             line(15 + 12.5 ** 0.5, 12.5 ** 0.5, 30, 10)]
+    rc = check("arc", edges, referenceCount(edges), totalLength(edges)) and rc
+    edges = makeGrid()
+    rc = check("grid", edges, referenceCount(edges), totalLength(edges)) and rc
+    return rc
+
+if __name__ == '__main__':
+    DProjectSplitTest()
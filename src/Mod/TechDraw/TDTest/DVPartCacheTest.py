@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# test script for TechDraw module
+# checks the saved hidden line removal and face results of a DrawViewPart
+# are reused after reopening the document and dropped after an edit
+from __future__ import print_function
+
+import FreeCAD
+import Part
+import Measure
+import TechDraw
+
+import os
+import tempfile
+
+def makeCurve(mid):
+    #open b-spline, only the middle pole moves with mid
+    curve = Part.BSplineCurve()
+    curve.buildFromPoles([FreeCAD.Vector(0,0,0), FreeCAD.Vector(10,mid,0),
+                          FreeCAD.Vector(20,-mid,0), FreeCAD.Vector(30,0,0)])
+    return curve.toShape()
+
+def DVPartCacheTest():
+    path = os.path.dirname(os.path.abspath(__file__))
+    print ('TDPartCache path: ' + path)
+    templateFileSpec = path + '/TestTemplate.svg'
+    fileName = os.path.join(tempfile.gettempdir(), "TDPartCache.FCStd")
+
+    doc = FreeCAD.newDocument("TDPartCache")
+    FreeCAD.setActiveDocument("TDPartCache")
+
+    box = doc.addObject("Part::Box","Box")
+    curve = doc.addObject("Part::Feature","Curve")
+    curve.Shape = makeCurve(5)
+
+    page = doc.addObject('TechDraw::DrawPage','Page')
+    doc.addObject('TechDraw::DrawSVGTemplate','Template')
+    doc.Template.Template = templateFileSpec
+    doc.Page.Template = doc.Template
+    page.Scale = 5.0
+
+    view = doc.addObject('TechDraw::DrawViewPart','View')
+    page.addView(view)
+    view.Source = [box]
+    curveView = doc.addObject('TechDraw::DrawViewPart','CurveView')
+    page.addView(curveView)
+    curveView.Source = [curve]
+    doc.recompute()
+
+    rc = True
+    edgeCount = len(view.getVisibleEdges())
+    hlrKey = view.HLRCacheKey
+    faceKey = view.FaceCacheKey
+    if not edgeCount or not hlrKey or not faceKey or view.FaceCache.isNull():
+        print("TDPartCache: no cached result")
+        rc = False
+
+    #reopen: the saved results must be used as they are
+    doc.saveAs(fileName)
+    FreeCAD.closeDocument("TDPartCache")
+    doc = FreeCAD.openDocument(fileName)
+    view = doc.getObject("View")
+    curveView = doc.getObject("CurveView")
+    hlr = view.HLRCache
+    faces = view.FaceCache
+    view.touch()
+    doc.recompute()
+    if view.HLRCacheKey != hlrKey or view.FaceCacheKey != faceKey:
+        print("TDPartCache: cache key changed after reopening")
+        rc = False
+    if not view.HLRCache.isSame(hlr) or not view.FaceCache.isSame(faces):
+        print("TDPartCache: saved result not reused after reopening")
+        rc = False
+    if len(view.getVisibleEdges()) != edgeCount:
+        print("TDPartCache: different edges from saved result")
+        rc = False
+
+    #an edit of the source must invalidate both results
+    doc.getObject("Box").Length = 20.0
+    doc.recompute()
+    if view.HLRCacheKey == hlrKey or view.FaceCacheKey == faceKey:
+        print("TDPartCache: cache not invalidated by an edit")
+        rc = False
+
+    #also if only the shape of a b-spline changes, not its end points
+    curveKey = curveView.HLRCacheKey
+    doc.getObject("Curve").Shape = makeCurve(8)
+    doc.recompute()
+    if curveView.HLRCacheKey == curveKey:
+        print("TDPartCache: cache not invalidated by a b-spline edit")
+        rc = False
+
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(fileName)
+    return rc
+
+if __name__ == '__main__':
+    DVPartCacheTest()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# test script for TechDraw module
+# checks that views projected together in parallel get the same edges as
+# views projected one at a time
+from __future__ import print_function
+
+import FreeCAD
+import Part
+import Measure
+import TechDraw
+
+import os
+
+def makeSources(doc):
+    box = doc.addObject("Part::Box","Box")
+    cylinder = doc.addObject("Part::Cylinder","Cylinder")
+    cylinder.Placement.Base = FreeCAD.Vector(30,0,0)
+    sphere = doc.addObject("Part::Sphere","Sphere")
+    sphere.Placement.Base = FreeCAD.Vector(60,0,0)
+    return [box, cylinder, sphere]
+
+def addViews(doc, page, sources, recomputeEach):
+    #every source from two directions, with the exact and the polygon algorithm
+    views = []
+    for source in sources:
+        for direction in [FreeCAD.Vector(0,0,1), FreeCAD.Vector(1,-1,1)]:
+            for coarse in [False, True]:
+                view = doc.addObject('TechDraw::DrawViewPart','View')
+                page.addView(view)
+                view.Source = [source]
+                view.Direction = direction
+                view.CoarseView = coarse
+                views.append(view)
+                if recomputeEach:
+                    doc.recompute()
+    if not recomputeEach:
+        doc.recompute()
+    return views
+
+def DVPartParallelTest():
+    path = os.path.dirname(os.path.abspath(__file__))
+    print ('TDPartParallel path: ' + path)
+    templateFileSpec = path + '/TestTemplate.svg'
+
+    doc = FreeCAD.newDocument("TDPartParallel")
+    FreeCAD.setActiveDocument("TDPartParallel")
+    sources = makeSources(doc)
+    doc.recompute()
+
+    page = doc.addObject('TechDraw::DrawPage','Page')
+    doc.addObject('TechDraw::DrawSVGTemplate','Template')
+    doc.Template.Template = templateFileSpec
+    doc.Page.Template = doc.Template
+    page.Scale = 1.0
+
+    #one view at a time, so there is nothing to project in parallel
+    serial = addViews(doc, page, sources, True)
+    #all views waiting for recompute are projected together
+    parallel = addViews(doc, page, sources, False)
+
+    rc = True
+    for s, p in zip(serial, parallel):
+        sVisible = len(s.getVisibleEdges())
+        sHidden = len(s.getHiddenEdges())
+        pVisible = len(p.getVisibleEdges())
+        pHidden = len(p.getHiddenEdges())
+        if not sVisible:
+            print("TDPartParallel: {} has no edges".format(s.Name))
+            rc = False
+        if (sVisible != pVisible) or (sHidden != pHidden):
+            print("TDPartParallel: {} has {}/{} edges, {} has {}/{}"
+                  .format(s.Name, sVisible, sHidden, p.Name, pVisible, pHidden))
+            rc = False
+
+    FreeCAD.closeDocument(doc.Name)
+    return rc
+
+if __name__ == '__main__':
+    DVPartParallelTest()
@@ -26,10 +26,14 @@ import time
 App = FreeCAD
 
 from TDTest.DHatchTest         import DHatchTest
+from TDTest.DGeomHatchTest     import DGeomHatchTest
 from TDTest.DProjGroupTest     import DProjGroupTest
 from TDTest.DVAnnoSymImageTest import DVAnnoSymImageTest
 from TDTest.DVDimensionTest    import DVDimensionTest
 from TDTest.DVPartTest         import DVPartTest
+from TDTest.DVPartCacheTest    import DVPartCacheTest
+from TDTest.DVPartParallelTest import DVPartParallelTest
+from TDTest.DProjectSplitTest  import DProjectSplitTest
 from TDTest.DVSectionTest      import DVSectionTest
 from TDTest.DVBalloonTest      import DVBalloonTest
 
@@ -47,6 +51,33 @@ class TechDrawTestCases(unittest.TestCase):
         else:
             print("TD DrawViewPart test failed")
 
+    def testViewPartCacheCase(self):
+        print("starting TD DrawViewPart cache test")
+        rc = DVPartCacheTest()
+        if rc:
+            print("TD DrawViewPart cache test passed")
+        else:
+            print("TD DrawViewPart cache test failed")
+        self.assertTrue(rc)
+
+    def testViewPartParallelCase(self):
+        print("starting TD DrawViewPart parallel test")
+        rc = DVPartParallelTest()
+        if rc:
+            print("TD DrawViewPart parallel test passed")
+        else:
+            print("TD DrawViewPart parallel test failed")
+        self.assertTrue(rc)
+
+    def testProjectSplitCase(self):
+        print("starting TD DrawProjectSplit test")
+        rc = DProjectSplitTest()
+        if rc:
+            print("TD DrawProjectSplit test passed")
+        else:
+            print("TD DrawProjectSplit test failed")
+        self.assertTrue(rc)
+
     def testHatchCase(self):
         print("starting TD DrawHatch test")
         rc = DHatchTest()
@@ -55,6 +86,15 @@ class TechDrawTestCases(unittest.TestCase):
         else:
             print("TD DrawHatch test failed")
 
+    def testGeomHatchCase(self):
+        print("starting TD DrawGeomHatch test")
+        rc = DGeomHatchTest()
+        if rc:
+            print("TD DrawGeomHatch test passed")
+        else:
+            print("TD DrawGeomHatch test failed")
+        self.assertTrue(rc)
+
     def testAnnoSymImageCase(self):
         print("starting TD DrawAnno/Sym/Image test")
         rc = DVAnnoSymImageTest()
@@ -157,6 +157,30 @@ class ParameterTestCase(unittest.TestCase):
         self.TestPar.RemString("44")
         self.failUnless(self.TestPar.GetString("44","hallo") == "hallo","Deletion error at String")
 
+    def testCachedValues(self):
+        # a missing entry must not hide a later set value
+        Temp = self.TestPar.GetGroup("Cache")
+        self.failUnless(Temp.GetInt("45",3) == 3,"Wrong default at Int")
+        Temp.SetInt("45",4711)
+        self.failUnless(Temp.GetInt("45",3) == 4711,"Cached value not updated at Int")
+        # same name with different types
+        Temp.SetBool("45",True)
+        self.failUnless(Temp.GetBool("45") == True,"Cached value not updated at Bool")
+        self.failUnless(Temp.GetInt("45") == 4711,"Wrong value of other type at Int")
+        # clearing the group drops all values
+        Temp.Clear()
+        self.failUnless(Temp.GetInt("45",3) == 3,"Cleared value still cached at Int")
+        self.failUnless(Temp.GetBool("45",False) == False,"Cleared value still cached at Bool")
+        # removing a single entry drops only that value
+        Temp.SetFloat("1.5",1.5)
+        Temp.SetString("str","text")
+        self.failUnless(Temp.GetFloat("1.5") == 1.5,"Wrong value at Float")
+        Temp.RemFloat("1.5")
+        self.failUnless(Temp.GetFloat("1.5",2.5) == 2.5,"Removed value still cached at Float")
+        self.failUnless(Temp.GetString("str") == "text","Wrong value after removing other entry")
+        Temp = 0
+        self.TestPar.RemGroup("Cache")
+
     def testMatrix(self):
         m=FreeCAD.Matrix(4,2,1,0,1,1,1,0,0,0,1,0,0,0,0,1)
         u=m.multiply(m.inverse())
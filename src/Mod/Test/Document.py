@@ -201,6 +201,31 @@ class DocumentBasicCases(unittest.TestCase):
     self.Doc.removeObject(obj.Name)
     self.assertListEqual(grp.Group, [])
 
+  def testCyclicLinkCheck(self):
+    Base = self.Doc.addObject("App::FeatureTest","Base")
+    Mid = self.Doc.addObject("App::FeatureTest","Mid")
+    Top = self.Doc.addObject("App::FeatureTest","Top")
+    Other = self.Doc.addObject("App::FeatureTest","Other")
+    Mid.Link = Base
+    Top.Link = Mid
+    # the check queries the (memoized) recursive in list of Base
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Top.Integer')
+
+    # a link elsewhere in the document must not disturb the check
+    Other.Link = Mid
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Top.Integer')
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Other.Integer')
+
+    # removing a link in the middle of the chain breaks the cycle
+    Top.Link = None
+    Base.setExpression('Integer', 'Top.Integer')
+    Base.setExpression('Integer', None)
+
+    # and linking it again through another object closes it
+    Top.Link = Other
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Top.Integer')
+    self.assertEqual(set(Base.InListRecursive), set([Mid, Top, Other]))
+
   def testPlacementList(self):
     obj = self.Doc.addObject("App::FeaturePython","Label")
     obj.addProperty("App::PropertyPlacementList", "PlmList")
@@ -866,6 +891,39 @@ class UndoRedoCases(unittest.TestCase):
     self.failUnless(len(self.Cylinder.InList) == 1)
     self.failUnless(self.Cylinder.InList[0] == self.Doc.Fuse)
 
+  def testUndoInListRecursive(self):
+
+    self.Doc.UndoMode = 1
+
+    self.Doc.openTransaction("Create")
+    Base = self.Doc.addObject('App::FeatureTest','Base')
+    Mid = self.Doc.addObject('App::FeatureTest','Mid')
+    Top = self.Doc.addObject('App::FeatureTest','Top')
+    Mid.Link = Base
+    Top.Link = Mid
+    self.Doc.commitTransaction()
+    self.assertEqual(set(Base.InListRecursive), set([Mid, Top]))
+
+    self.Doc.openTransaction("Delete")
+    self.Doc.removeObject('Top')
+    self.Doc.commitTransaction()
+    self.assertEqual(Base.InListRecursive, [Mid])
+    # this queries the in list of Base while Top is detached
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Mid.Integer')
+
+    # the restored object must show up in the in list again
+    self.Doc.undo()
+    Top = self.Doc.getObject('Top')
+    self.failUnless(Top is not None)
+    self.assertEqual(set(Base.InListRecursive), set([Mid, Top]))
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Top.Integer')
+
+    self.Doc.redo()
+    self.failUnless(self.Doc.getObject('Top') is None)
+    self.assertEqual(Base.InListRecursive, [Mid])
+    self.Doc.undo()
+    self.assertRaises(Exception, Base.setExpression, 'Integer', 'Top.Integer')
+
   def testUndoIssue0003150Part1(self):
 
     self.Doc.UndoMode = 1
@@ -908,6 +966,36 @@ class UndoRedoCases(unittest.TestCase):
     self.Doc.undo()
     self.failUnless(self.Doc.recompute() >= 0)
 
+  def testUndoPropertyChangedTwice(self):
+    # the transaction keeps the value from before its first change
+    self.Doc.UndoMode = 1
+    obj = self.Doc.getObject("Base")
+    obj.Integer = 1
+    obj.String = "old"
+    obj.FloatList = [1.0, 2.0, 3.0]
+
+    self.Doc.openTransaction("Change")
+    obj.Integer = 2
+    obj.String = "new"
+    obj.FloatList = [4.0, 5.0]
+    obj.Integer = 3
+    obj.FloatList = [6.0]
+    self.Doc.commitTransaction()
+
+    self.Doc.undo()
+    self.assertEqual(obj.Integer, 1)
+    self.assertEqual(obj.String, "old")
+    self.assertEqual(obj.FloatList, [1.0, 2.0, 3.0])
+
+    self.Doc.redo()
+    self.assertEqual(obj.Integer, 3)
+    self.assertEqual(obj.String, "new")
+    self.assertEqual(obj.FloatList, [6.0])
+
+    self.Doc.undo()
+    self.assertEqual(obj.Integer, 1)
+    self.assertEqual(obj.FloatList, [1.0, 2.0, 3.0])
+
   def tearDown(self):
     # closing doc
     FreeCAD.closeDocument("UndoTest")
@@ -1109,6 +1197,36 @@ class DocumentGroupCases(unittest.TestCase):
     self.prt.removeObject(self.fus1)
     self.failUnless(len(self.prt.Group)==0)
 
+  def testSubObjectCacheLabel(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L1.Label = "Old"
+    G1 = self.Doc.addObject("App::DocumentObjectGroup","Group")
+    G1.addObject(L1)
+    # resolveSubElement() goes through the cached sub-object lookup
+    self.failUnless(G1.resolveSubElement("$Old.")[0] == L1)
+    L1.Label = "New"
+    self.failUnless(G1.resolveSubElement("$Old.")[0] is None)
+    self.failUnless(G1.resolveSubElement("$New.")[0] == L1)
+
+  def testSubObjectCachePythonOverride(self):
+    class SubObjectProxy:
+      def __init__(self, obj, target):
+        self.target = target
+        obj.Proxy = self
+      def getSubObject(self, obj, subname, retType, matrix, transform, depth):
+        if subname != "Child.":
+          return False
+        return (self.target, matrix)
+
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    obj = self.Doc.addObject("App::FeaturePython","Python")
+    proxy = SubObjectProxy(obj, L1)
+    self.failUnless(obj.resolveSubElement("Child.")[0] == L1)
+    # no property is changed, so the result must not come from the cache
+    proxy.target = L2
+    self.failUnless(obj.resolveSubElement("Child.")[0] == L2)
+
   def tearDown(self):
     # closing doc
     FreeCAD.closeDocument("GroupTests")
@@ -1819,6 +1937,57 @@ class DocumentObserverCases(unittest.TestCase):
     self.Obs.parameter = []
     self.Obs.parameter2 = []
     
+  def testChangeBatch(self):
+    self.Doc1 = FreeCAD.newDocument("Observer1")
+    obj1 = self.Doc1.addObject("App::FeaturePython","obj1")
+    obj1.addProperty("App::PropertyInteger","Value")
+    obj2 = self.Doc1.addObject("App::FeaturePython","obj2")
+    obj2.addProperty("App::PropertyLink","Link")
+    obj2.addProperty("App::PropertyInteger","Value")
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
+    with FreeCAD.ChangeBatch():
+      for i in range(10):
+        obj2.Value = i
+        obj1.Value = i
+      obj2.Link = obj1
+      # only the change notification is deferred
+      self.failUnless('ObjBeforeChange' in self.Obs.signal)
+      self.failUnless('ObjChanged' not in self.Obs.signal)
+      self.failUnless(obj1.Value == 9 and obj2.Value == 9)
+
+    changes = [(o.Name,p) for s,o,p in zip(self.Obs.signal,self.Obs.parameter,self.Obs.parameter2) \
+                  if s == 'ObjChanged']
+    # one notification per object and property, dependency first
+    self.failUnless(changes == [('obj1','Value'),('obj2','Value'),('obj2','Link')])
+    self.assertRaises(RuntimeError, FreeCAD.closeChangeBatch)
+
+    # an exception inside the block still closes the batch
+    self.Obs.signal = []
+    try:
+      with FreeCAD.ChangeBatch():
+        obj1.Value = 10
+        raise ValueError()
+    except ValueError:
+      pass
+    self.failUnless('ObjChanged' in self.Obs.signal)
+    self.assertRaises(RuntimeError, FreeCAD.closeChangeBatch)
+
+    # pending notification is sent before a recompute
+    self.Obs.signal = []
+    with FreeCAD.ChangeBatch():
+      obj1.Value = 11
+      self.failUnless('ObjChanged' not in self.Obs.signal)
+      self.Doc1.recompute()
+      self.failUnless('ObjChanged' in self.Obs.signal)
+
+    FreeCAD.closeDocument(self.Doc1.Name)
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
   def testUndoDisabledDocument(self):
 
     # testing document level signals
@@ -80,6 +80,7 @@ Gui.addWorkbench(TestWorkbench())
 
 # Base system tests
 FreeCAD.__unit_test__ += [ "Workbench",
+                           "SelectionTests",
                            "Menu",
                            "Menu.MenuDeleteCases",
                            "Menu.MenuCreateCases" ]
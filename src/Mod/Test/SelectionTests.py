@@ -0,0 +1,65 @@
+#***************************************************************************
+#*   Copyright (c) 2020 FreeCAD Project Association                        *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Library General Public License for more details.                  *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+import FreeCAD, FreeCADGui, unittest
+
+class SelectionCases(unittest.TestCase):
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("SelectionTest")
+        self.Obj = self.Doc.addObject("App::FeatureTest","Test")
+        FreeCADGui.Selection.clearSelection()
+
+    def getSubNames(self):
+        sel = FreeCADGui.Selection.getSelectionEx("SelectionTest",0)
+        self.failUnless(len(sel) == 1, "Expected one selected object")
+        return sel[0].SubElementNames
+
+    def testAddSelectionList(self):
+        # a list of subnames is added in one batch
+        FreeCADGui.Selection.addSelection(self.Obj,["Face1","Face2","Face3"])
+        self.assertEqual(sorted(self.getSubNames()),["Face1","Face2","Face3"])
+        self.failUnless(FreeCADGui.Selection.isSelected(self.Obj,"Face2",0))
+
+        # entries that are already selected are not added again
+        FreeCADGui.Selection.addSelection(self.Obj,("Face1","Face4"))
+        self.assertEqual(sorted(self.getSubNames()),["Face1","Face2","Face3","Face4"])
+
+        FreeCADGui.Selection.removeSelection(self.Obj,"Face1")
+        self.assertEqual(sorted(self.getSubNames()),["Face2","Face3","Face4"])
+
+        # without subname all entries of the object are removed
+        FreeCADGui.Selection.removeSelection(self.Obj)
+        self.failIf(FreeCADGui.Selection.hasSelection("SelectionTest"))
+
+    def testAddSelectionListGate(self):
+        # the selection gate applies to each entry of the list
+        FreeCADGui.Selection.addSelectionGate("SELECT App::FeatureTest SUBELEMENT Edge")
+        try:
+            FreeCADGui.Selection.addSelection(self.Obj,["Edge1","Face1","Edge2"])
+        finally:
+            FreeCADGui.Selection.removeSelectionGate()
+        self.assertEqual(sorted(self.getSubNames()),["Edge1","Edge2"])
+
+    def tearDown(self):
+        FreeCADGui.Selection.clearSelection()
+        FreeCAD.closeDocument("SelectionTest")